@@ -298,9 +298,8 @@ struct Array {
     {
         static_assert(S2 <= S, "The size of the source array must be less than or equal to the size of this array");
 
-        for (std::size_t i = 0; i <= S; i++) {
-            _data[i] = x[i];
-        }
+        // The elements past S2 are left as they are
+        ArrayOps::copy(data(), x.data(), S2);
     }
 
     template <std::size_t S2>
@@ -311,9 +310,8 @@ struct Array {
     {
         static_assert(S2 <= S, "The size of the source array must be less than or equal to the size of this array");
 
-        for (std::size_t i = 0; i <= S; i++) {
-            _data[i] = x[i];
-        }
+        // The elements past S2 are left as they are
+        ArrayOps::copy(data(), x.data(), S2);
     }
 
     void
@@ -321,9 +319,7 @@ struct Array {
         typename Traits::ConstType from
     )
     {
-        for (std::size_t i = 0; i < S; i++) {
-            _data[i] = from[i];
-        }
+        ArrayOps::copy(data(), &from[0], S);
     }
 
     void
@@ -331,9 +327,7 @@ struct Array {
         typename Traits::Type to
     ) const
     {
-        for (std::size_t i = 0; i < S; i++) {
-            to[i] = _data[i];
-        }
+        ArrayOps::copy(&to[0], data(), S);
     }
 };
 
@@ -345,13 +339,7 @@ operator==(
     const Array<T, S>& rhs
 )
 {
-    for (std::size_t i = 0; i < S; i++) {
-        if (lhs[i] != rhs[i]) {
-            return false;
-        }
-    }
-
-    return true;
+    return ArrayOps::equal(lhs.data(), rhs.data(), S);
 }
 
 template <typename T, std::size_t S>
@@ -361,13 +349,7 @@ operator==(
     const Array<T, S>& rhs
 )
 {
-    for (std::size_t i = 0; i < S; i++) {
-        if (lhs[i] != rhs[i]) {
-            return false;
-        }
-    }
-
-    return true;
+    return ArrayOps::equal(&lhs[0], rhs.data(), S);
 }
 
 template <typename T, std::size_t S>
@@ -387,13 +369,7 @@ operator==(
     const ConstArray<T, S>& rhs
 )
 {
-    for (std::size_t i = 0; i < S; i++) {
-        if (lhs[i] != rhs[i]) {
-            return false;
-        }
-    }
-
-    return true;
+    return ArrayOps::equal(lhs.data(), rhs.data(), S);
 }
 
 template <typename T, std::size_t S>
@@ -403,13 +379,7 @@ operator==(
     const Array<T, S>& rhs
 )
 {
-    for (std::size_t i = 0; i < S; i++) {
-        if (lhs[i] != rhs[i]) {
-            return false;
-        }
-    }
-
-    return true;
+    return ArrayOps::equal(lhs.data(), rhs.data(), S);
 }
 
 template <typename T, std::size_t S>
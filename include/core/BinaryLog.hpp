@@ -0,0 +1,292 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/CoreType.hpp>
+
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Binary log record header
+ *
+ * A record is made of the header, followed by the arguments.
+ * Each argument is a CoreType tag byte, followed by the raw (native endian) bytes of the value.
+ * Strings are tagged as CoreType::CHAR, followed by a 16 bit length (\0 included) and by the characters.
+ * A nullptr string is recorded with a length of 0 and no characters.
+ */
+struct BinaryLogHeader {
+    uint16_t size; //!< Size of the record, header included
+    uint8_t  arguments; //!< Number of arguments
+    uint8_t  reserved;
+    uint64_t format; //!< Address of the format string
+    uint64_t timestamp; //!< Timestamp
+} CORE_PACKED;
+
+/*! \brief Binary log argument encoder
+ *
+ * \tparam T type of the argument
+ */
+template <typename T, typename ENABLE = void>
+struct BinaryLogArgument {
+    static_assert(std::is_arithmetic<T>::value, "Only integers, floating points and strings can be logged");
+    static_assert(!std::is_floating_point<T>::value || (sizeof(T) <= sizeof(double)), "long double cannot be logged");
+
+    static constexpr CoreType
+    type()
+    {
+        return std::is_floating_point<T>::value ? ((sizeof(T) == 4) ? CoreType::FLOAT32 : CoreType::FLOAT64)
+               : (sizeof(T) == 1) ? (std::is_signed<T>::value ? CoreType::INT8 : CoreType::UINT8)
+               : (sizeof(T) == 2) ? (std::is_signed<T>::value ? CoreType::INT16 : CoreType::UINT16)
+               : (sizeof(T) == 4) ? (std::is_signed<T>::value ? CoreType::INT32 : CoreType::UINT32)
+               : (std::is_signed<T>::value ? CoreType::INT64 : CoreType::UINT64);
+    }
+
+    static constexpr std::size_t
+    size(
+        const T&
+    )
+    {
+        return 1 + sizeof(T);
+    }
+
+    static uint8_t*
+    write(
+        uint8_t* p,
+        const T& value
+    )
+    {
+        *p++ = static_cast<uint8_t>(type());
+        std::memcpy(p, &value, sizeof(T));
+        return p + sizeof(T);
+    }
+};
+
+template <typename T>
+struct BinaryLogArgument<T, typename std::enable_if<std::is_convertible<const T&, const char*>::value>::type>{
+    static std::size_t
+    length(
+        const char* s
+    )
+    {
+        return (s != nullptr) ? strlen(s) : 0;
+    }
+
+    static std::size_t
+    size(
+        const T& value
+    )
+    {
+        const char* s = value;
+
+        return 1 + sizeof(uint16_t) + ((s != nullptr) ? length(s) + 1 : 0);
+    }
+
+    static uint8_t*
+    write(
+        uint8_t* p,
+        const T& value
+    )
+    {
+        const char* s = value;
+        uint16_t    n = (s != nullptr) ? static_cast<uint16_t>(length(s) + 1) : 0;
+
+        *p++ = static_cast<uint8_t>(CoreType::CHAR);
+        std::memcpy(p, &n, sizeof(n));
+        p += sizeof(n);
+
+        if (n > 0) {
+            std::memcpy(p, s, n - 1);
+            p[n - 1] = 0;
+        }
+
+        return p + n;
+    }
+};
+
+/*! \brief Deferred binary log
+ *
+ * core::BinaryLog records log calls without formatting them: only the address of the format string,
+ * a timestamp and the raw bytes of the arguments are copied into a preallocated buffer.
+ * The text is rebuilt later (possibly on the host) with BinaryLogReader and BinaryLogRecord::print.
+ *
+ * The cost of a call does not depend on the format string, only on the size of the arguments.
+ * String arguments are copied, so they do not need to outlive the call.
+ *
+ * \warning The format string must be a literal (or otherwise outlive the log), as only its address is stored.
+ * \warning It is not thread safe, like StringBuffer.
+ *
+ * \tparam SIZE size of the buffer
+ */
+template <std::size_t SIZE>
+class BinaryLog
+{
+    static_assert(SIZE >= sizeof(BinaryLogHeader), "SIZE must be at least as large as a record header");
+
+public:
+    BinaryLog()
+    {
+        reset();
+    }
+
+    /*! \brief Record a log call
+     *
+     * \return true if the record fitted in the buffer
+     */
+    template <typename ... ARGS>
+    bool
+    log(
+        uint64_t    timestamp, //!< [in] timestamp
+        const char* format, //!< [in] printf format string
+        const ARGS& ... args //!< [in] arguments
+    )
+    {
+        static_assert(sizeof ... (ARGS) <= 0xFF, "Too many arguments");
+
+        std::size_t size = sizeof(BinaryLogHeader) + sizeOf(args ...);
+
+        if ((size > free()) || (size > 0xFFFF)) {
+            return false;
+        }
+
+        BinaryLogHeader header;
+        header.size      = static_cast<uint16_t>(size);
+        header.arguments = static_cast<uint8_t>(sizeof ... (ARGS));
+        header.reserved  = 0;
+        header.format    = reinterpret_cast<uintptr_t>(format);
+        header.timestamp = timestamp;
+
+        std::memcpy(_curr, &header, sizeof(header));
+        write(_curr + sizeof(header), args ...);
+        _curr += size;
+
+        return true;
+    }
+
+    void
+    reset()
+    {
+        _curr = _data;
+    }
+
+    /*! \brief Recorded data
+     *
+     */
+    const uint8_t*
+    data() const
+    {
+        return _data;
+    }
+
+    /*! \brief Length of the recorded data
+     *
+     */
+    std::size_t
+    length() const
+    {
+        return _curr - _data;
+    }
+
+    std::size_t
+    free() const
+    {
+        return (_data + SIZE) - _curr;
+    }
+
+private:
+    static constexpr std::size_t
+    sizeOf()
+    {
+        return 0;
+    }
+
+    template <typename T, typename ... ARGS>
+    static std::size_t
+    sizeOf(
+        const T& value,
+        const ARGS& ... args
+    )
+    {
+        return BinaryLogArgument<T>::size(value) + sizeOf(args ...);
+    }
+
+    static void
+    write(
+        uint8_t*
+    ) {}
+
+    template <typename T, typename ... ARGS>
+    static void
+    write(
+        uint8_t* p,
+        const T& value,
+        const ARGS& ... args
+    )
+    {
+        write(BinaryLogArgument<T>::write(p, value), args ...);
+    }
+
+    uint8_t  _data[SIZE];
+    uint8_t* _curr = nullptr;
+};
+
+/*! \brief Binary log record
+ *
+ */
+struct BinaryLogRecord {
+    uint64_t       format; //!< Address of the format string (on the target)
+    uint64_t       timestamp; //!< Timestamp
+    std::size_t    arguments; //!< Number of arguments
+    const uint8_t* data; //!< Encoded arguments
+    std::size_t    length; //!< Length of the encoded arguments
+
+    /*! \brief Rebuild the text of the record
+     *
+     * The output is the same appendFormat(format, ...) would have produced on the target.
+     * Placeholders are printed with snprintf, after the arguments have been converted as the length modifiers require.
+     * A '*' field width or precision consumes an integer argument, as in printf.
+     *
+     * \return number of bytes written (not including the \0)
+     * \retval -1 the buffer was not large enough, or the arguments do not match the format string
+     */
+    int
+    print(
+        char*       buffer, //!< [out] destination buffer
+        std::size_t length, //!< [in] length of the destination buffer
+        const char* format //!< [in] the format string, as resolved from the \c format address
+    ) const;
+};
+
+/*! \brief Binary log reader
+ *
+ * Splits the data recorded by a BinaryLog into records.
+ */
+class BinaryLogReader
+{
+public:
+    BinaryLogReader(
+        const uint8_t* data, //!< [in] recorded data
+        std::size_t    length //!< [in] length of the recorded data
+    ) : _curr(data), _end(data + length) {}
+
+    /*! \brief Get the next record
+     *
+     * \return false when there are no more records, or if the data is corrupted
+     */
+    bool
+    next(
+        BinaryLogRecord& record
+    );
+
+private:
+    const uint8_t* _curr;
+    const uint8_t* _end;
+};
+
+NAMESPACE_CORE_END
@@ -0,0 +1,504 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/NumberFormat.hpp>
+#include <core/Format.hpp>
+#include <core/StringBuffer.hpp>
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+
+#if defined(__has_include)
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define CORE_HAS_IOVEC 1
+#endif
+#endif
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Segment of a ChainedStringBuffer
+ *
+ * It has the same layout of struct iovec, so an array of segments can be handed to writev as is
+ * (checked at compile time where <sys/uio.h> exists).
+ */
+struct StringBufferSegment {
+    void*       base; //!< Start of the segment
+    std::size_t length; //!< Number of bytes used
+};
+
+#ifdef CORE_HAS_IOVEC
+static_assert(sizeof(StringBufferSegment) == sizeof(struct iovec), "StringBufferSegment must have the layout of struct iovec");
+static_assert(offsetof(StringBufferSegment, base) == offsetof(struct iovec, iov_base), "StringBufferSegment must have the layout of struct iovec");
+static_assert(offsetof(StringBufferSegment, length) == offsetof(struct iovec, iov_len), "StringBufferSegment must have the layout of struct iovec");
+#endif
+
+/*! \brief Pool of fixed size segments
+ *
+ * The free segments are kept in an intrusive list.
+ *
+ * \warning It is not thread safe.
+ *
+ * \tparam SEGMENT_SIZE size of a segment
+ */
+template <std::size_t SEGMENT_SIZE>
+class StringSegmentPool:
+    private core::Uncopyable
+{
+    static_assert(SEGMENT_SIZE >= sizeof(void*), "SEGMENT_SIZE must be large enough to hold a pointer");
+
+public:
+    /*! \brief Get a segment
+     *
+     * \return pointer to the segment, nullptr if the pool is empty
+     */
+    char*
+    alloc()
+    {
+        char* segment = _head;
+
+        if (segment != nullptr) {
+            std::memcpy(&_head, segment, sizeof(_head));
+        }
+
+        return segment;
+    }
+
+    /*! \brief Give a segment back
+     *
+     */
+    void
+    free(
+        char* segment
+    )
+    {
+        std::memcpy(segment, &_head, sizeof(_head));
+        _head = segment;
+    }
+
+    /*! \brief Add segments to the pool
+     *
+     */
+    void
+    grow(
+        char*       storage, //!< [in] storage for \c count segments
+        std::size_t count //!< [in] number of segments
+    )
+    {
+        for (std::size_t i = 0; i < count; i++) {
+            free(storage + i * SEGMENT_SIZE);
+        }
+    }
+
+protected:
+    StringSegmentPool() : _head(nullptr) {}
+
+private:
+    char* _head;
+};
+
+/*! \brief Pool of fixed size segments, with static storage
+ *
+ * \tparam SEGMENT_SIZE size of a segment
+ * \tparam COUNT number of segments
+ */
+template <std::size_t SEGMENT_SIZE, std::size_t COUNT>
+class StaticStringSegmentPool:
+    public StringSegmentPool<SEGMENT_SIZE>
+{
+public:
+    StaticStringSegmentPool()
+    {
+        this->grow(_storage, COUNT);
+    }
+
+private:
+    char _storage[SEGMENT_SIZE * COUNT] CORE_MEMORY_ALIGNED;
+};
+
+/*! \brief ChainedStringBuffer
+ *
+ * core::ChainedStringBuffer has the same append API of StringBuffer, but instead of failing when a segment is full
+ * it continues into a new one, taken from a pool.
+ * The content is never linearized: it is exposed as a scatter list (see StringBufferSegment), ready for writev.
+ *
+ * Strings are split across segments, while formatted items (formats, formatters, numbers) are kept contiguous:
+ * an item that does not fit in the current segment is written at the beginning of a new one,
+ * and an item larger than a segment makes the append fail.
+ * As the writers (snprintf, NumberFormat, ...) need room for a terminating \0, an item of n characters needs n + 1 free bytes:
+ * so the largest item is SEGMENT_SIZE - 1 characters long, and one of exactly SEGMENT_SIZE characters fails too.
+ *
+ * The segments are not \0 terminated.
+ *
+ * \warning It is not thread safe, like StringBuffer.
+ *
+ * \tparam SEGMENT_SIZE size of a segment
+ * \tparam MAX_SEGMENTS maximum number of segments
+ */
+template <std::size_t SEGMENT_SIZE, std::size_t MAX_SEGMENTS>
+class ChainedStringBuffer:
+    private core::Uncopyable
+{
+    static_assert(MAX_SEGMENTS >= 1, "MAX_SEGMENTS must be at least 1");
+
+public:
+    using Pool = StringSegmentPool<SEGMENT_SIZE>;
+
+    ChainedStringBuffer(
+        Pool& pool
+    ) : _pool(pool), _count(0), _markCount(0), _markLength(0) {}
+
+    ~ChainedStringBuffer()
+    {
+        reset();
+    }
+
+    inline bool
+    appendString(
+        const char* s
+    )
+    {
+        return appendString(s, static_cast<size_t>(-1));
+    }
+
+    /*! \brief Append at most \c n characters of a string
+     *
+     * \return false if the pool (or the segment list) ran out before the whole string was appended
+     */
+    inline bool
+    appendString(
+        const char* s,
+        size_t      n
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        if ((n == 0) || (*s == 0)) {
+            return true;
+        }
+
+        for (;;) {
+            std::size_t m = available();
+
+            if (m > n) {
+                m = n;
+            }
+
+            const void* end = memchr(s, 0, m);
+
+            if (end != nullptr) {
+                m = static_cast<const char*>(end) - s;
+                n = m;
+            }
+
+            if (m > 0) {
+                std::memcpy(tail(), s, m);
+                _segments[_count - 1].length += m;
+                s += m;
+            }
+
+            n -= m;
+
+            if (n == 0) {
+                return true;
+            }
+
+            if (!next()) {
+                return false;
+            }
+        }
+    } // appendString
+
+    inline bool
+    appendChar(
+        const char c
+    )
+    {
+        if ((available() == 0) && !next()) {
+            return false;
+        }
+
+        *tail() = c;
+        _segments[_count - 1].length++;
+
+        return true;
+    }
+
+    bool
+    appendFormat(
+        const char* format,
+        ...
+    )
+    {
+        va_list ap;
+
+        va_start(ap, format);
+        bool success = emplace([&](char* buffer, std::size_t length) {
+                va_list aq;
+                va_copy(aq, ap);
+                int n = vsnprintf(buffer, length, format, aq);
+                va_end(aq);
+                return ((n >= 0) && (static_cast<std::size_t>(n) < length)) ? n : -1;
+            });
+        va_end(ap);
+
+        return success;
+    }
+
+    bool
+    appendInt(
+        int64_t value
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatInt(buffer, length, value);
+            });
+    }
+
+    bool
+    appendUInt(
+        uint64_t value
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatUInt(buffer, length, value);
+            });
+    }
+
+    bool
+    appendHex(
+        uint64_t value,
+        unsigned width = 0,
+        bool     upper = false
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatHex(buffer, length, value, width, upper);
+            });
+    }
+
+    bool
+    appendFixed(
+        double   value,
+        unsigned precision = 6
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatFixed(buffer, length, value, precision);
+            });
+    }
+
+    bool
+    appendFloat(
+        float value
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatShortest(buffer, length, value);
+            });
+    }
+
+    bool
+    appendFloat(
+        double value
+    ) = delete;
+
+    bool
+    appendDouble(
+        double value
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return NumberFormat::formatShortest(buffer, length, value);
+            });
+    }
+
+    template <typename F, typename ... ARGS>
+    bool
+    appendFmt(
+        F           format,
+        const ARGS& ... args
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                return Format::format(format, buffer, length, args ...);
+            });
+    }
+
+    bool
+    appendFrmttr(
+        FormatterFunction* function,
+        const void*        data
+    )
+    {
+        return appendFormatter(function, data);
+    }
+
+    bool
+    appendFormatter(
+        FormatterFunction* function,
+        const void*        data
+    )
+    {
+        return emplace([&](char* buffer, std::size_t length) {
+                int n = function(buffer, length, data);
+                return ((n >= 0) && (static_cast<std::size_t>(n) < length)) ? n : -1;
+            });
+    }
+
+    void
+    mark()
+    {
+        _markCount  = _count;
+        _markLength = (_count > 0) ? _segments[_count - 1].length : 0;
+    }
+
+    /*! \brief Go back to the mark
+     *
+     * The segments allocated after the mark are given back to the pool.
+     */
+    void
+    rewind()
+    {
+        while (_count > _markCount) {
+            _pool.free(static_cast<char*>(_segments[--_count].base));
+        }
+
+        if (_count > 0) {
+            _segments[_count - 1].length = _markLength;
+        }
+    }
+
+    /*! \brief Clear the buffer
+     *
+     * All the segments are given back to the pool.
+     */
+    void
+    reset()
+    {
+        while (_count > 0) {
+            _pool.free(static_cast<char*>(_segments[--_count].base));
+        }
+
+        _markCount  = 0;
+        _markLength = 0;
+    }
+
+    /*! \brief Total length of the content
+     *
+     */
+    std::size_t
+    length() const
+    {
+        std::size_t n = 0;
+
+        for (std::size_t i = 0; i < _count; i++) {
+            n += _segments[i].length;
+        }
+
+        return n;
+    }
+
+    /*! \brief Scatter list
+     *
+     * \return pointer to the first of segmentCount() segments
+     */
+    const StringBufferSegment*
+    segments() const
+    {
+        return _segments;
+    }
+
+    /*! \brief Number of segments in use
+     *
+     */
+    std::size_t
+    segmentCount() const
+    {
+        return _count;
+    }
+
+private:
+    // Free space in the current segment
+    std::size_t
+    available() const
+    {
+        return (_count > 0) ? SEGMENT_SIZE - _segments[_count - 1].length : 0;
+    }
+
+    char*
+    tail()
+    {
+        return static_cast<char*>(_segments[_count - 1].base) + _segments[_count - 1].length;
+    }
+
+    bool
+    next()
+    {
+        if (_count == MAX_SEGMENTS) {
+            return false;
+        }
+
+        char* segment = _pool.alloc();
+
+        if (segment == nullptr) {
+            return false;
+        }
+
+        _segments[_count].base   = segment;
+        _segments[_count].length = 0;
+        _count++;
+
+        return true;
+    }
+
+    // Write a formatted item, in the current segment if it fits, at the beginning of a new one otherwise
+    template <typename WRITER>
+    bool
+    emplace(
+        WRITER writer
+    )
+    {
+        if (available() > 0) {
+            int n = writer(tail(), available());
+
+            if (n >= 0) {
+                _segments[_count - 1].length += n;
+                return true;
+            }
+        }
+
+        if (!next()) {
+            return false;
+        }
+
+        int n = writer(tail(), SEGMENT_SIZE);
+
+        if (n < 0) {
+            // Larger than a segment, give the new one back
+            _pool.free(static_cast<char*>(_segments[--_count].base));
+            return false;
+        }
+
+        _segments[_count - 1].length += n;
+        return true;
+    } // emplace
+
+    Pool& _pool;
+    StringBufferSegment _segments[MAX_SEGMENTS];
+    std::size_t         _count;
+    std::size_t         _markCount;
+    std::size_t         _markLength;
+};
+
+NAMESPACE_CORE_END
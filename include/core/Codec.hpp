@@ -0,0 +1,346 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+#include <core/ConstArray.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Character to value table of a codec
+ *
+ * Invalid characters map to INVALID.
+ */
+struct CodecTable {
+    static const uint8_t INVALID = 0x80;
+
+    uint8_t value[256];
+};
+
+/*! \brief Hexadecimal encoding
+ *
+ * The encoders follow the snprintf conventions, as NumberFormat does.
+ * The decoders return the number of decoded bytes, or -1 if the input is not valid or the output is too small;
+ * in that case the content of the output is undefined.
+ */
+namespace Hex {
+constexpr CodecTable
+makeTable()
+{
+    CodecTable table = {{0}};
+
+    for (unsigned c = 0; c < 256; c++) {
+        table.value[c] = CodecTable::INVALID;
+    }
+
+    for (unsigned c = '0'; c <= '9'; c++) {
+        table.value[c] = static_cast<uint8_t>(c - '0');
+    }
+
+    for (unsigned c = 'a'; c <= 'f'; c++) {
+        table.value[c] = static_cast<uint8_t>(c - 'a' + 10);
+        table.value[c - 'a' + 'A'] = static_cast<uint8_t>(c - 'a' + 10);
+    }
+
+    return table;
+}
+
+inline const CodecTable&
+table()
+{
+    static constexpr CodecTable TABLE = makeTable();
+
+    return TABLE;
+}
+
+/*! \brief Encode binary data
+ *
+ * Two bytes at a time: their four nibbles are spread into the bytes of a 32 bit word,
+ * and turned into digits with byte-parallel arithmetic.
+ */
+inline int
+encode(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    const void* data, //!< [in] data
+    std::size_t n, //!< [in] length of the data
+    bool        upper = false //!< [in] use uppercase digits
+)
+{
+    if ((2 * n) >= length) {
+        return -1;
+    }
+
+    const uint8_t* in     = static_cast<const uint8_t*>(data);
+    const uint32_t letter = upper ? ('A' - '0' - 10) : ('a' - '0' - 10);
+    char*          out    = buffer;
+    std::size_t    i      = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        const uint32_t b0 = in[i];
+        const uint32_t b1 = in[i + 1];
+
+        // Little endian: the first character goes in the lowest byte
+        uint32_t nibbles = (b0 >> 4) | ((b0 & 0x0F) << 8) | ((b1 >> 4) << 16) | ((b1 & 0x0F) << 24);
+        uint32_t letters = ((nibbles + 0x06060606u) >> 4) & 0x01010101u; // 1 in the bytes >= 10
+        uint32_t chars   = nibbles + 0x30303030u + letters * letter;
+
+        out[0] = static_cast<char>(chars);
+        out[1] = static_cast<char>(chars >> 8);
+        out[2] = static_cast<char>(chars >> 16);
+        out[3] = static_cast<char>(chars >> 24);
+        out   += 4;
+    }
+
+    if (i < n) {
+        const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        *out++ = digits[in[i] >> 4];
+        *out++ = digits[in[i] & 0x0F];
+    }
+
+    *out = 0;
+
+    return static_cast<int>(2 * n);
+} // encode
+
+/*! \brief Decode hexadecimal text (either case)
+ *
+ */
+inline int
+decode(
+    void*       data, //!< [out] destination
+    std::size_t size, //!< [in] size of the destination
+    const char* s, //!< [in] text
+    std::size_t n //!< [in] length of the text
+)
+{
+    if (((n & 1) != 0) || ((n / 2) > size)) {
+        return -1;
+    }
+
+    const uint8_t* t     = table().value;
+    uint8_t*       out   = static_cast<uint8_t*>(data);
+    uint8_t        check = 0;
+
+    // Validate once at the end, the loop has no branches
+    for (std::size_t i = 0; i < n; i += 2) {
+        const uint8_t hi = t[static_cast<uint8_t>(s[i])];
+        const uint8_t lo = t[static_cast<uint8_t>(s[i + 1])];
+        check   |= hi | lo;
+        *out++   = static_cast<uint8_t>((hi << 4) | (lo & 0x0F));
+    }
+
+    return (check & CodecTable::INVALID) ? -1 : static_cast<int>(n / 2);
+}
+
+template <std::size_t S>
+inline int
+decode(
+    Array<uint8_t, S>& data, //!< [out] destination
+    const char*        s, //!< [in] text
+    std::size_t        n //!< [in] length of the text
+)
+{
+    return decode(data.data(), S, s, n);
+}
+
+template <std::size_t S, std::size_t N>
+inline int
+decode(
+    Array<uint8_t, S>&         data, //!< [out] destination
+    const ConstArray<char, N>& s //!< [in] text
+)
+{
+    return decode(data.data(), S, s.data(), N);
+}
+}
+
+/*! \brief Base64 encoding (RFC 4648, with padding)
+ *
+ * Same conventions of Hex.
+ */
+namespace Base64 {
+inline const char*
+alphabet()
+{
+    return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+constexpr CodecTable
+makeTable()
+{
+    CodecTable table = {{0}};
+    const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    for (unsigned c = 0; c < 256; c++) {
+        table.value[c] = CodecTable::INVALID;
+    }
+
+    for (unsigned i = 0; i < 64; i++) {
+        table.value[static_cast<uint8_t>(alphabet[i])] = static_cast<uint8_t>(i);
+    }
+
+    return table;
+}
+
+inline const CodecTable&
+table()
+{
+    static constexpr CodecTable TABLE = makeTable();
+
+    return TABLE;
+}
+
+/*! \brief Length of the encoding of \c n bytes
+ *
+ */
+constexpr std::size_t
+encodedLength(
+    std::size_t n
+)
+{
+    return ((n + 2) / 3) * 4;
+}
+
+/*! \brief Encode binary data
+ *
+ */
+inline int
+encode(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    const void* data, //!< [in] data
+    std::size_t n //!< [in] length of the data
+)
+{
+    if (encodedLength(n) >= length) {
+        return -1;
+    }
+
+    const uint8_t* in  = static_cast<const uint8_t*>(data);
+    const char*    a   = alphabet();
+    char*          out = buffer;
+    std::size_t    i   = 0;
+
+    for (; i + 3 <= n; i += 3) {
+        const uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | (static_cast<uint32_t>(in[i + 1]) << 8) | in[i + 2];
+
+        out[0] = a[(v >> 18) & 0x3F];
+        out[1] = a[(v >> 12) & 0x3F];
+        out[2] = a[(v >> 6) & 0x3F];
+        out[3] = a[v & 0x3F];
+        out   += 4;
+    }
+
+    if (i < n) {
+        const uint32_t v = (static_cast<uint32_t>(in[i]) << 16) | ((i + 1 < n) ? (static_cast<uint32_t>(in[i + 1]) << 8) : 0);
+
+        out[0] = a[(v >> 18) & 0x3F];
+        out[1] = a[(v >> 12) & 0x3F];
+        out[2] = (i + 1 < n) ? a[(v >> 6) & 0x3F] : '=';
+        out[3] = '=';
+        out   += 4;
+    }
+
+    *out = 0;
+
+    return static_cast<int>(out - buffer);
+} // encode
+
+/*! \brief Decode base64 text
+ *
+ * The length must be a multiple of 4, and padding is only accepted at the end.
+ */
+inline int
+decode(
+    void*       data, //!< [out] destination
+    std::size_t size, //!< [in] size of the destination
+    const char* s, //!< [in] text
+    std::size_t n //!< [in] length of the text
+)
+{
+    if ((n & 3) != 0) {
+        return -1;
+    }
+
+    if (n == 0) {
+        return 0;
+    }
+
+    const std::size_t padding = (s[n - 1] == '=') ? ((s[n - 2] == '=') ? 2 : 1) : 0;
+    const std::size_t m       = (n / 4) * 3 - padding;
+
+    if (m > size) {
+        return -1;
+    }
+
+    const uint8_t* t     = table().value;
+    uint8_t*       out   = static_cast<uint8_t*>(data);
+    uint8_t        check = 0;
+    std::size_t    i     = 0;
+
+    // Full quads, validated once at the end
+    for (; i + 4 < n; i += 4) {
+        const uint8_t a = t[static_cast<uint8_t>(s[i])];
+        const uint8_t b = t[static_cast<uint8_t>(s[i + 1])];
+        const uint8_t c = t[static_cast<uint8_t>(s[i + 2])];
+        const uint8_t d = t[static_cast<uint8_t>(s[i + 3])];
+        check |= a | b | c | d;
+
+        const uint32_t v = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) | (static_cast<uint32_t>(c) << 6) | d;
+        out[0] = static_cast<uint8_t>(v >> 16);
+        out[1] = static_cast<uint8_t>(v >> 8);
+        out[2] = static_cast<uint8_t>(v);
+        out   += 3;
+    }
+
+    // Last quad, possibly padded
+    const uint8_t a = t[static_cast<uint8_t>(s[i])];
+    const uint8_t b = t[static_cast<uint8_t>(s[i + 1])];
+    const uint8_t c = (padding >= 2) ? 0 : t[static_cast<uint8_t>(s[i + 2])];
+    const uint8_t d = (padding >= 1) ? 0 : t[static_cast<uint8_t>(s[i + 3])];
+    check |= a | b | c | d;
+
+    const uint32_t v = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) | (static_cast<uint32_t>(c) << 6) | d;
+    out[0] = static_cast<uint8_t>(v >> 16);
+
+    if (padding < 2) {
+        out[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    if (padding < 1) {
+        out[2] = static_cast<uint8_t>(v);
+    }
+
+    return (check & CodecTable::INVALID) ? -1 : static_cast<int>(m);
+} // decode
+
+template <std::size_t S>
+inline int
+decode(
+    Array<uint8_t, S>& data, //!< [out] destination
+    const char*        s, //!< [in] text
+    std::size_t        n //!< [in] length of the text
+)
+{
+    return decode(data.data(), S, s, n);
+}
+
+template <std::size_t S, std::size_t N>
+inline int
+decode(
+    Array<uint8_t, S>&         data, //!< [out] destination
+    const ConstArray<char, N>& s //!< [in] text
+)
+{
+    return decode(data.data(), S, s.data(), N);
+}
+}
+
+NAMESPACE_CORE_END
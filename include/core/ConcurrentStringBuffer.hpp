@@ -0,0 +1,315 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/NumberFormat.hpp>
+#include <core/Format.hpp>
+#include <core/StringBuffer.hpp>
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief ConcurrentStringBuffer
+ *
+ * core::ConcurrentStringBuffer is a StringBuffer that many threads can append to without locks.
+ *
+ * Each append is a record: its text is prepared on the stack (if it needs formatting), then its byte range is reserved
+ * with a single atomic fetch-add on the write cursor, and finally it is copied in place.
+ * Records are never truncated: an append either fits as a whole or fails.
+ *
+ * Visibility: the cursor word also counts the appends in flight.
+ * The append that brings that count back to zero knows that everything below the cursor has been written,
+ * and publishes it as committed(). Readers only look at [data(), data() + committed()), so they only see complete records.
+ * No writer ever waits for another one.
+ *
+ * \warning At most MAX_APPENDERS (255) appends can be in flight at the same time, i.e. at most 255 threads and interrupt
+ * handlers can append to the same buffer: the count has 8 bits, and a 256th append would wrap it to zero and commit
+ * records still being written. The count cannot be wider: the cursor needs the other 24 bits of the word,
+ * as each append in flight can overshoot SIZE by up to SIZE bytes, and 64 bit atomics are not lock-free on Cortex-M.
+ * \warning The content is not \0 terminated.
+ * \warning reset() must not be called while appends are in flight.
+ *
+ * \tparam SIZE size of the buffer (up to 64 KiB)
+ * \tparam ITEM_SIZE size of the stack buffer used to prepare formatted records
+ */
+template <std::size_t SIZE, std::size_t ITEM_SIZE = 128>
+class ConcurrentStringBuffer:
+    private core::Uncopyable
+{
+    static_assert(SIZE >= 1, "SIZE must be at least 1");
+    static_assert(SIZE <= 0xFFFF, "SIZE must fit in 16 bits, so that overshooting reservations cannot overflow the cursor");
+
+    // State word: cursor in the low 24 bits, appends in flight in the high 8 bits
+    static const uint32_t WRITER_SHIFT = 24;
+    static const uint32_t WRITER       = static_cast<uint32_t>(1) << WRITER_SHIFT;
+    static const uint32_t CURSOR_MASK  = WRITER - 1;
+
+public:
+    static const uint32_t MAX_APPENDERS = 0xFF; //!< maximum number of appends in flight
+
+    ConcurrentStringBuffer()
+    {
+        reset();
+    }
+
+    inline bool
+    appendString(
+        const char* s
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        return append(s, strlen(s));
+    }
+
+    inline bool
+    appendString(
+        const char* s,
+        size_t      n
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        const void* end = memchr(s, 0, n);
+
+        if (end != nullptr) {
+            n = static_cast<const char*>(end) - s;
+        }
+
+        return append(s, n);
+    }
+
+    inline bool
+    appendChar(
+        const char c
+    )
+    {
+        return append(&c, 1);
+    }
+
+    bool
+    appendFormat(
+        const char* format,
+        ...
+    )
+    {
+        char    item[ITEM_SIZE];
+        va_list ap;
+
+        va_start(ap, format);
+        int n = vsnprintf(item, sizeof(item), format, ap);
+        va_end(ap);
+
+        if ((n < 0) || (static_cast<std::size_t>(n) >= sizeof(item))) {
+            return false;
+        }
+
+        return append(item, n);
+    }
+
+    bool
+    appendInt(
+        int64_t value
+    )
+    {
+        char item[24];
+        return appendItem(item, NumberFormat::formatInt(item, sizeof(item), value));
+    }
+
+    bool
+    appendUInt(
+        uint64_t value
+    )
+    {
+        char item[24];
+        return appendItem(item, NumberFormat::formatUInt(item, sizeof(item), value));
+    }
+
+    bool
+    appendHex(
+        uint64_t value,
+        unsigned width = 0,
+        bool     upper = false
+    )
+    {
+        char item[ITEM_SIZE];
+        return appendItem(item, NumberFormat::formatHex(item, sizeof(item), value, width, upper));
+    }
+
+    bool
+    appendFixed(
+        double   value,
+        unsigned precision = 6
+    )
+    {
+        char item[ITEM_SIZE];
+        return appendItem(item, NumberFormat::formatFixed(item, sizeof(item), value, precision));
+    }
+
+    bool
+    appendFloat(
+        float value
+    )
+    {
+        char item[16];
+        return appendItem(item, NumberFormat::formatShortest(item, sizeof(item), value));
+    }
+
+    bool
+    appendFloat(
+        double value
+    ) = delete;
+
+    bool
+    appendDouble(
+        double value
+    )
+    {
+        char item[32];
+        return appendItem(item, NumberFormat::formatShortest(item, sizeof(item), value));
+    }
+
+    template <typename F, typename ... ARGS>
+    bool
+    appendFmt(
+        F           format,
+        const ARGS& ... args
+    )
+    {
+        char item[ITEM_SIZE];
+        return appendItem(item, Format::format(format, item, sizeof(item), args ...));
+    }
+
+    bool
+    appendFormatter(
+        FormatterFunction* function,
+        const void*        data
+    )
+    {
+        char item[ITEM_SIZE];
+        int  n = function(item, sizeof(item), data);
+
+        if ((n >= 0) && (static_cast<std::size_t>(n) >= sizeof(item))) {
+            return false;
+        }
+
+        return appendItem(item, n);
+    }
+
+    /*! \brief Append a record
+     *
+     * \return false if the record does not fit
+     */
+    bool
+    append(
+        const char* s, //!< [in] record
+        std::size_t n //!< [in] length of the record
+    )
+    {
+        if (n == 0) {
+            return true;
+        }
+
+        // Fail early, so that the cursor can only overshoot SIZE by the appends in flight
+        if (((_state.load(std::memory_order_relaxed) & CURSOR_MASK) + n) > SIZE) {
+            return false;
+        }
+
+        uint32_t    state   = _state.fetch_add(static_cast<uint32_t>(n) + WRITER, std::memory_order_relaxed);
+        std::size_t begin   = state & CURSOR_MASK;
+        bool        success = (begin + n) <= SIZE;
+
+        CORE_ASSERT((state >> WRITER_SHIFT) < MAX_APPENDERS);
+
+        if (success) {
+            std::memcpy(_data + begin, s, n);
+        } else if (begin < SIZE) {
+            // The only reservation straddling the end: the bytes from here on will never be written
+            _limit.store(begin, std::memory_order_relaxed);
+        }
+
+        commit();
+
+        return success;
+    } // append
+
+    /*! \brief Length of the content that is safe to read
+     *
+     */
+    std::size_t
+    committed() const
+    {
+        return _committed.load(std::memory_order_acquire);
+    }
+
+    /*! \brief Direct access to the content
+     *
+     * Only the first committed() bytes are meaningful.
+     */
+    const char*
+    data() const
+    {
+        return _data;
+    }
+
+    void
+    reset()
+    {
+        _state.store(0, std::memory_order_relaxed);
+        _limit.store(SIZE, std::memory_order_relaxed);
+        _committed.store(0, std::memory_order_release);
+    }
+
+private:
+    bool
+    appendItem(
+        const char* item,
+        int         n
+    )
+    {
+        return (n >= 0) ? append(item, n) : false;
+    }
+
+    void
+    commit()
+    {
+        // acq_rel: the last append out also acquires what the others have written
+        uint32_t state = _state.fetch_sub(WRITER, std::memory_order_acq_rel);
+
+        if ((state >> WRITER_SHIFT) != 1) {
+            return;
+        }
+
+        std::size_t end   = state & CURSOR_MASK;
+        std::size_t limit = _limit.load(std::memory_order_relaxed);
+
+        if (end > limit) {
+            end = limit;
+        }
+
+        // Quiescent points are not published in order, keep the largest
+        std::size_t committed = _committed.load(std::memory_order_relaxed);
+
+        while ((committed < end) && !_committed.compare_exchange_weak(committed, end, std::memory_order_release, std::memory_order_relaxed)) {}
+    } // commit
+
+    char _data[SIZE];
+    std::atomic<uint32_t>    _state;
+    std::atomic<std::size_t> _limit;
+    std::atomic<std::size_t> _committed;
+};
+
+NAMESPACE_CORE_END
@@ -9,6 +9,7 @@
 #include <core/namespace.hpp>
 #include <core/common.hpp>
 #include <memory>
+#include <type_traits>
 
 NAMESPACE_CORE_BEGIN
 
@@ -43,6 +44,148 @@ struct ConstArrayTraits<T, 0>{
     }
 };
 
+/*! \brief Bulk operations on arrays of T
+ *
+ * Used by Array and ConstArray: types that can be copied or compared as raw bytes go through memcpy and memcmp,
+ * which copy and compare whole words (or vectors) at a time; the others keep the element by element loops.
+ */
+namespace ArrayOps {
+/*! \brief Tell whether two T are equal exactly when their bytes are
+ *
+ * True for integers, enums and pointers. Floating point types are not: 0.0 == -0.0, and NaN != NaN.
+ * It can be specialized for structs with no padding, whose members are all bitwise comparable.
+ */
+template <typename T>
+struct IsBitwiseComparable:
+    public std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value>
+{};
+
+template <typename T>
+inline void
+copy(
+    T*          to,
+    const T*    from,
+    std::size_t n,
+    std::true_type // trivially copyable
+)
+{
+    if (n != 0) {
+        std::memcpy(to, from, n * sizeof(T));
+    }
+}
+
+template <typename T>
+inline void
+copy(
+    T*          to,
+    const T*    from,
+    std::size_t n,
+    std::false_type
+)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        to[i] = from[i];
+    }
+}
+
+/*! \brief Copy \c n elements
+ *
+ * \pre the ranges do not overlap
+ */
+template <typename T>
+inline void
+copy(
+    T*          to,
+    const T*    from,
+    std::size_t n
+)
+{
+    ArrayOps::copy(to, from, n, std::is_trivially_copyable<T>());
+}
+
+template <typename T>
+inline bool
+equal(
+    const T*    a,
+    const T*    b,
+    std::size_t n,
+    std::true_type // bitwise comparable
+)
+{
+    return (n == 0) || (std::memcmp(a, b, n * sizeof(T)) == 0);
+}
+
+template <typename T>
+inline bool
+equal(
+    const T*    a,
+    const T*    b,
+    std::size_t n,
+    std::false_type
+)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*! \brief Compare \c n elements
+ *
+ */
+template <typename T>
+inline bool
+equal(
+    const T*    a,
+    const T*    b,
+    std::size_t n
+)
+{
+    return ArrayOps::equal(a, b, n, IsBitwiseComparable<T>());
+}
+
+template <typename T>
+inline bool
+equalFloating(
+    const T*    a,
+    const T*    b,
+    std::size_t n
+)
+{
+    // No early exit, so that the loop can be vectorized
+    std::size_t same = 0;
+
+    for (std::size_t i = 0; i < n; i++) {
+        same += (a[i] == b[i]) ? 1 : 0;
+    }
+
+    return same == n;
+}
+
+inline bool
+equal(
+    const float* a,
+    const float* b,
+    std::size_t  n
+)
+{
+    return equalFloating(a, b, n);
+}
+
+inline bool
+equal(
+    const double* a,
+    const double* b,
+    std::size_t   n
+)
+{
+    return equalFloating(a, b, n);
+}
+}
+
 /*! \brief ConstArray
  *
  * core::ConstArray encapsulates a fixed size constant array.
@@ -205,9 +348,7 @@ struct ConstArray {
         typename Traits::Type to
     ) const
     {
-        for (std::size_t i = 0; i < S; i++) {
-            to[i] = _data[i];
-        }
+        ArrayOps::copy(&to[0], _data, S);
     }
 };
 
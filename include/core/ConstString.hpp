@@ -35,10 +35,9 @@ struct ConstString {
     using Traits = ConstArrayTraits<char, S>;
     const_pointer _data;
 
-    ConstString(const_pointer data) {
-        _data = data;
-    }
-        
+    constexpr
+    ConstString(const_pointer data) : _data(data) {}
+
     // Capacity.
     /*! \brief Get the size of the array
      *
@@ -54,13 +53,13 @@ struct ConstString {
      *
      * \return const pointer to the underlying element storage
      */
-    const_pointer
+    constexpr const_pointer
     data() const
     {
-        return std::__addressof(Traits::ref(_data, 0));
+        return _data;
     }
 
-    const char*
+    constexpr const char*
     c_str() const
     {
         return data();
@@ -72,16 +71,17 @@ struct ConstString {
         _data[0] = 0;
     }
 
+    /*! \brief Length of the string
+     *
+     * memchr is word-at-a-time (or SIMD) in any decent libc, and it stops at the \0,
+     * that may well come before S when the pointed string is a literal. Use SizedString when the length is needed often.
+     */
     std::size_t
     length() const
     {
-        for (std::size_t i = 0; i < S; i++) {
-            if (_data[i] == 0) {
-                return i;
-            }
-        }
+        const void* end = memchr(_data, 0, S);
 
-        return S;
+        return (end != nullptr) ? static_cast<std::size_t>(static_cast<const char*>(end) - _data) : S;
     }
 
     /*! \brief Cast operator
@@ -11,6 +11,8 @@
 #include <core/Array.hpp>
 #include <core/String.hpp>
 
+#include <type_traits>
+
 #ifndef CORETYPE_TIMESTAMP_TYPE
 #include <ctime>
 
@@ -204,8 +206,12 @@ struct CoreTypeTraitsHelperB<uint16_t>{
     static const CoreType types = CoreType::UINT16;
 };
 
+// int is int32_t on some toolchains (e.g. Linux), a different type on others (e.g. arm-none-eabi, where int32_t is long):
+// in the first case the specialization for int32_t covers it, and this one is for a type that is never used
+struct CoreTypeIntIsInt32 {};
+
 template <>
-struct CoreTypeTraitsHelperB<int>{
+struct CoreTypeTraitsHelperB<std::conditional<std::is_same<int, int32_t>::value, CoreTypeIntIsInt32, int>::type>{
     static const CoreType types = CoreType::INT32;
 };
 
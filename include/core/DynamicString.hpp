@@ -0,0 +1,538 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/String.hpp>
+#include <core/StringView.hpp>
+
+#include <functional>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Arena for strings
+ *
+ * Bump allocator over caller supplied storage: allocating moves a pointer, freeing gives back only the last block,
+ * and reset() frees everything at once (e.g. at the end of a frame).
+ *
+ * \warning It is not thread safe.
+ * \warning Strings allocated from the arena must not be used after reset().
+ */
+class StringArena:
+    private core::Uncopyable
+{
+public:
+    StringArena(
+        char*       storage, //!< [in] storage
+        std::size_t size //!< [in] its size
+    ) : _begin(storage), _curr(storage), _top(storage + size) {}
+
+    /*! \brief Get \c n bytes
+     *
+     * \return pointer to the block, nullptr if there is no room
+     */
+    void*
+    allocate(
+        std::size_t n
+    )
+    {
+        if (n > static_cast<std::size_t>(_top - _curr)) {
+            return nullptr;
+        }
+
+        char* block = _curr;
+
+        _curr += n;
+
+        return block;
+    }
+
+    /*! \brief Give a block back
+     *
+     * Only the last allocated block is actually reclaimed.
+     */
+    void
+    deallocate(
+        void*       block,
+        std::size_t n
+    )
+    {
+        if (static_cast<char*>(block) + n == _curr) {
+            _curr = static_cast<char*>(block);
+        }
+    }
+
+    /*! \brief Free all the blocks
+     *
+     */
+    void
+    reset()
+    {
+        _curr = _begin;
+    }
+
+    /*! \brief Number of bytes in use
+     *
+     */
+    std::size_t
+    used() const
+    {
+        return static_cast<std::size_t>(_curr - _begin);
+    }
+
+    std::size_t
+    size() const
+    {
+        return static_cast<std::size_t>(_top - _begin);
+    }
+
+private:
+    char* const _begin;
+    char*       _curr;
+    char* const _top;
+};
+
+/*! \brief Arena for strings, with static storage
+ *
+ * \tparam SIZE size of the storage
+ */
+template <std::size_t SIZE>
+class StaticStringArena:
+    public StringArena
+{
+public:
+    StaticStringArena() : StringArena(_storage, SIZE) {}
+
+private:
+    char _storage[SIZE];
+};
+
+/*! \brief DynamicString
+ *
+ * core::DynamicString is a \0 terminated string that grows as needed, without using the heap:
+ * - up to INLINE_CAPACITY (23) characters are stored in the object itself, with no allocation;
+ * - longer strings are stored in blocks taken from an allocator supplied by the caller, such as StringArena.
+ *
+ * \code
+ * core::StaticStringArena<4096> arena;
+ *
+ * core::DynamicString<> path(node.name, &arena); // from a String, ConstString, StringBuffer, ...
+ * path += '/';
+ * path += topic.name;
+ * ...
+ * arena.reset(); // once per frame, when the strings are gone
+ * \endcode
+ *
+ * A string without allocator never grows past INLINE_CAPACITY.
+ * As in PaddedString, mutations that do not fit (the allocator ran out) truncate the result and return false.
+ *
+ * The last inline byte holds INLINE_CAPACITY - length(), which is also the terminating \0 of a full inline string,
+ * or HEAP when the characters are in an allocated block.
+ *
+ * A DynamicString converts to StringView, so it compares with, and can be passed to, anything taking a StringView;
+ * copyTo() fills a String, and StringBuffer::appendString(s.c_str(), s.length()) appends it to a buffer.
+ *
+ * \tparam ALLOCATOR has void* allocate(std::size_t) and void deallocate(void*, std::size_t), as StringArena
+ */
+template <typename ALLOCATOR = StringArena>
+class DynamicString
+{
+public:
+    using size_type = std::size_t;
+
+    static const size_type INLINE_CAPACITY = 23;
+
+    explicit
+    DynamicString(
+        ALLOCATOR* allocator = nullptr
+    ) : _allocator(allocator)
+    {
+        setInline(0);
+    }
+
+    DynamicString(
+        const StringView& s,
+        ALLOCATOR*        allocator = nullptr
+    ) : _allocator(allocator)
+    {
+        setInline(0);
+        append(s.data(), s.length());
+    }
+
+    DynamicString(
+        const DynamicString& other
+    ) : _allocator(other._allocator)
+    {
+        setInline(0);
+        append(other.data(), other.length());
+    }
+
+    DynamicString(
+        DynamicString&& other
+    ) : _allocator(other._allocator)
+    {
+        std::memcpy(_inline, other._inline, sizeof(_inline));
+        other.setInline(0);
+    }
+
+    ~DynamicString()
+    {
+        release();
+    }
+
+    DynamicString&
+    operator=(
+        const DynamicString& other
+    )
+    {
+        if (&other != this) {
+            assign(other.data(), other.length());
+        }
+
+        return *this;
+    }
+
+    /*! \brief Move assignment
+     *
+     * The allocated block is taken over only if both strings use the same allocator; otherwise it is a copy.
+     */
+    DynamicString&
+    operator=(
+        DynamicString&& other
+    )
+    {
+        if (&other == this) {
+            return *this;
+        }
+
+        if ((_allocator != other._allocator) && !other.isInline()) {
+            assign(other.data(), other.length());
+            return *this;
+        }
+
+        release();
+        std::memcpy(_inline, other._inline, sizeof(_inline));
+        other.setInline(0);
+
+        return *this;
+    }
+
+    DynamicString&
+    operator=(
+        const StringView& s
+    )
+    {
+        assign(s.data(), s.length());
+        return *this;
+    }
+
+    DynamicString&
+    operator+=(
+        const StringView& s
+    )
+    {
+        append(s.data(), s.length());
+        return *this;
+    }
+
+    DynamicString&
+    operator+=(
+        char c
+    )
+    {
+        append(&c, 1);
+        return *this;
+    }
+
+    const char*
+    data() const
+    {
+        return isInline() ? _inline : _heap.data;
+    }
+
+    const char*
+    c_str() const
+    {
+        return data();
+    }
+
+    size_type
+    length() const
+    {
+        return isInline() ? INLINE_CAPACITY - static_cast<uint8_t>(_inline[INLINE_CAPACITY]) : _heap.length;
+    }
+
+    size_type
+    size() const
+    {
+        return length();
+    }
+
+    bool
+    empty() const
+    {
+        return length() == 0;
+    }
+
+    /*! \brief Number of characters that fit without allocating
+     *
+     */
+    size_type
+    capacity() const
+    {
+        return isInline() ? INLINE_CAPACITY : _heap.capacity;
+    }
+
+    char
+    operator[](
+        size_type i
+    ) const
+    {
+        return data()[i];
+    }
+
+    const char*
+    begin() const
+    {
+        return data();
+    }
+
+    const char*
+    end() const
+    {
+        return data() + length();
+    }
+
+    StringView
+    view() const
+    {
+        return StringView(data(), length());
+    }
+
+    operator StringView() const {
+        return view();
+    }
+
+    ALLOCATOR*
+    allocator() const
+    {
+        return _allocator;
+    }
+
+    /*! \brief Make room for \c n characters
+     *
+     * The capacity at least doubles, so that appending one character at a time costs O(1) on average.
+     *
+     * \return false if there is no allocator, or it ran out
+     */
+    bool
+    reserve(
+        size_type n
+    )
+    {
+        const size_type c = capacity();
+
+        if (n <= c) {
+            return true;
+        }
+
+        if ((_allocator == nullptr) || (n > MAX_CAPACITY)) {
+            return false;
+        }
+
+        const size_type m     = (n < 2 * c) ? ((2 * c < MAX_CAPACITY) ? 2 * c : MAX_CAPACITY) : n;
+        char* const     block = static_cast<char*>(_allocator->allocate(m + 1));
+
+        if (block == nullptr) {
+            return false;
+        }
+
+        const size_type l = length();
+
+        std::memcpy(block, data(), l + 1);
+        release();
+
+        _heap.data     = block;
+        _heap.length   = l;
+        _heap.capacity = static_cast<uint32_t>(m);
+        _inline[INLINE_CAPACITY] = static_cast<char>(HEAP);
+
+        return true;
+    } // reserve
+
+    /*! \brief Empty the string, keeping its storage
+     *
+     */
+    void
+    clear()
+    {
+        setLength(0);
+    }
+
+    /*! \brief Replace the characters with \c n characters from \c s
+     *
+     * \c s may point into the string itself.
+     */
+    bool
+    assign(
+        const char* s,
+        size_type   n
+    )
+    {
+        if (overlaps(s)) {
+            std::memmove(mutableData(), s, n);
+            setLength(n);
+            return true;
+        }
+
+        setLength(0);
+
+        return append(s, n);
+    }
+
+    /*! \brief Append \c n characters from \c s
+     *
+     * \c s may point into the string itself.
+     */
+    bool
+    append(
+        const char* s,
+        size_type   n
+    )
+    {
+        const size_type l      = length();
+        const bool      self   = overlaps(s);
+        const size_type offset = self ? static_cast<size_type>(s - data()) : 0;
+        const bool      fits   = reserve(l + n);
+
+        if (self) {
+            // reserve() may have moved the characters
+            s = data() + offset;
+        }
+
+        if (!fits) {
+            n = capacity() - l;
+        }
+
+        std::memmove(mutableData() + l, s, n);
+        setLength(l + n);
+
+        return fits;
+    } // append
+
+    bool
+    append(
+        const StringView& s
+    )
+    {
+        return append(s.data(), s.length());
+    }
+
+    /*! \brief Copy the characters to a String
+     *
+     * As in String, the result is \0 terminated only if it is shorter than S.
+     *
+     * \return false if they do not fit, and have been truncated
+     */
+    template <std::size_t S>
+    bool
+    copyTo(
+        String<S>& s
+    ) const
+    {
+        const size_type l = length();
+        const size_type n = (l < S) ? l : S;
+
+        std::memcpy(s.data(), data(), n);
+        std::memset(s.data() + n, 0, S - n);
+
+        return n == l;
+    }
+
+    /*! \brief Hash of the characters, as computed by Hash::string
+     *
+     */
+    uint64_t
+    hash() const
+    {
+        return view().hash();
+    }
+
+private:
+    static const uint8_t   HEAP = 0xFF;
+    static const size_type MAX_CAPACITY = 0xFFFFFFFEu;
+
+    struct Heap {
+        char*     data;
+        size_type length;
+        uint32_t  capacity; //!< 32 bit, so that the last inline byte is left free
+    };
+
+    static_assert(sizeof(char*) + sizeof(size_type) + sizeof(uint32_t) <= INLINE_CAPACITY, "The last inline byte must not overlap Heap");
+
+    bool
+    isInline() const
+    {
+        return static_cast<uint8_t>(_inline[INLINE_CAPACITY]) != HEAP;
+    }
+
+    char*
+    mutableData()
+    {
+        return isInline() ? _inline : _heap.data;
+    }
+
+    bool
+    overlaps(
+        const char* s
+    ) const
+    {
+        const std::less_equal<const char*> le;
+
+        return le(data(), s) && le(s, data() + length());
+    }
+
+    void
+    setInline(
+        size_type n
+    )
+    {
+        _inline[n] = 0;
+        _inline[INLINE_CAPACITY] = static_cast<char>(INLINE_CAPACITY - n);
+    }
+
+    void
+    setLength(
+        size_type n
+    )
+    {
+        if (isInline()) {
+            setInline(n);
+        } else {
+            _heap.data[n] = 0;
+            _heap.length  = n;
+        }
+    }
+
+    void
+    release()
+    {
+        if (!isInline()) {
+            _allocator->deallocate(_heap.data, _heap.capacity + 1);
+            setInline(0);
+        }
+    }
+
+    ALLOCATOR* _allocator;
+    union {
+        char _inline[INLINE_CAPACITY + 1];
+        Heap _heap;
+    };
+};
+
+NAMESPACE_CORE_END
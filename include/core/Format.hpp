@@ -0,0 +1,613 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/NumberFormat.hpp>
+
+#include <type_traits>
+
+/*! \brief Compile time format string
+ *
+ * Wraps a string literal into a type, so that it can be parsed at compile time.
+ *
+ * \code
+ * buffer.appendFmt(CORE_FORMAT("%s: %5d (0x%04x) %.3f"), name, value, flags, ratio);
+ * \endcode
+ */
+#define CORE_FORMAT(__s__) \
+    ([] { \
+        struct CoreFormatString { \
+            static constexpr const char* str() { \
+                return __s__; \
+            } \
+        }; \
+        return CoreFormatString(); \
+    } ())
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Compile time parsed, type safe printf
+ *
+ * The format string (see CORE_FORMAT) is parsed by the compiler: every literal run becomes a fixed size copy,
+ * and every placeholder a direct call to the writer of its conversion.
+ * The output is identical to the one of snprintf.
+ *
+ * Supported placeholders are \c %[-0][width][.precision][length]conversion, with conversion one of
+ * \c d \c i \c u \c x \c X \c f \c c \c s and \c %.
+ * Length modifiers convert the argument as printf does: \c %hhd of 300 writes 44, \c %hu of -1 writes 65535.
+ * Without one, integers are written with their own type, whatever it is. \c l and \c L are accepted, and ignored, by \c %f.
+ *
+ * Unsupported placeholders, arguments whose type does not match the conversion,
+ * and a wrong number of arguments do not compile.
+ */
+namespace Format {
+/*! \brief Parsed placeholder
+ *
+ */
+struct Spec {
+    char        conversion; //!< conversion character, 0 if the string is over
+    bool        left; //!< '-' flag
+    bool        zero; //!< '0' flag
+    bool        valid; //!< the placeholder is supported
+    unsigned    width; //!< minimum field width
+    int         precision; //!< precision, -1 if not specified
+    char        length; //!< length modifier: 0, 'H' (hh), 'h', 'l', 'q' (ll), 'z', 'j', 't' or 'L'
+    std::size_t end; //!< index of the first character after the placeholder
+};
+
+constexpr bool
+isDigit(
+    char c
+)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+/*! \brief Find the next placeholder
+ *
+ * \return index of the next '%', or of the terminating \0
+ */
+constexpr std::size_t
+next(
+    const char* s,
+    std::size_t i
+)
+{
+    while ((s[i] != 0) && (s[i] != '%')) {
+        i++;
+    }
+
+    return i;
+}
+
+/*! \brief Parse the placeholder starting at \c i
+ *
+ */
+constexpr Spec
+parse(
+    const char* s,
+    std::size_t i
+)
+{
+    Spec spec = {0, false, false, true, 0, -1, 0, i};
+
+    if (s[i] == 0) {
+        return spec;
+    }
+
+    i++; // '%'
+
+    for (;;) {
+        if (s[i] == '-') {
+            spec.left = true;
+        } else if (s[i] == '0') {
+            spec.zero = true;
+        } else if ((s[i] == '+') || (s[i] == ' ') || (s[i] == '#')) {
+            spec.valid = false;
+        } else {
+            break;
+        }
+
+        i++;
+    }
+
+    while (isDigit(s[i])) {
+        spec.width = spec.width * 10 + (s[i++] - '0');
+    }
+
+    if (s[i] == '*') {
+        spec.valid = false;
+        i++;
+    }
+
+    if (s[i] == '.') {
+        i++;
+        spec.precision = 0;
+
+        while (isDigit(s[i])) {
+            spec.precision = spec.precision * 10 + (s[i++] - '0');
+        }
+
+        if (s[i] == '*') {
+            spec.valid = false;
+            i++;
+        }
+    }
+
+    if ((s[i] == 'h') || (s[i] == 'l') || (s[i] == 'z') || (s[i] == 'j') || (s[i] == 't') || (s[i] == 'L')) {
+        spec.length = s[i++];
+
+        if ((spec.length == 'h') && (s[i] == 'h')) {
+            spec.length = 'H';
+            i++;
+        } else if ((spec.length == 'l') && (s[i] == 'l')) {
+            spec.length = 'q';
+            i++;
+        }
+    }
+
+    spec.conversion = s[i];
+    spec.end        = (s[i] != 0) ? i + 1 : i;
+
+    switch (spec.conversion) {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+          // No precision for integers
+          spec.valid = spec.valid && (spec.precision < 0) && (spec.length != 'L');
+          break;
+      case 'f':
+          spec.valid = spec.valid && ((spec.length == 0) || (spec.length == 'l') || (spec.length == 'L'));
+          break;
+      case 'c':
+          // No wide characters
+          spec.valid = spec.valid && (spec.precision < 0) && !spec.zero && (spec.length == 0);
+          break;
+      case 's':
+          spec.valid = spec.valid && !spec.zero && (spec.length == 0);
+          break;
+      case '%':
+          spec.valid = spec.valid && (spec.width == 0) && (spec.precision < 0) && !spec.left && !spec.zero && (spec.length == 0);
+          break;
+      default:
+          spec.valid = false;
+    } // switch
+
+    return spec;
+} // parse
+
+/*! \brief Count the placeholders that consume an argument
+ *
+ */
+constexpr std::size_t
+countArguments(
+    const char* s
+)
+{
+    std::size_t n = 0;
+    std::size_t i = next(s, 0);
+
+    while (s[i] != 0) {
+        Spec spec = parse(s, i);
+
+        if (spec.conversion != '%') {
+            n++;
+        }
+
+        i = next(s, spec.end);
+    }
+
+    return n;
+}
+
+/*! \brief Check that all the placeholders are supported
+ *
+ */
+constexpr bool
+isValid(
+    const char* s
+)
+{
+    std::size_t i = next(s, 0);
+
+    while (s[i] != 0) {
+        Spec spec = parse(s, i);
+
+        if (!spec.valid) {
+            return false;
+        }
+
+        i = next(s, spec.end);
+    }
+
+    return true;
+}
+
+/*! \brief Apply the field width to an already written field
+ *
+ * \return the field length, -1 if it does not fit
+ */
+inline int
+pad(
+    char*       buffer,
+    std::size_t length,
+    int         n,
+    const Spec& spec
+)
+{
+    if ((n < 0) || (static_cast<std::size_t>(n) >= spec.width)) {
+        return n;
+    }
+
+    if (spec.width >= length) {
+        return -1;
+    }
+
+    std::size_t fill = spec.width - n;
+
+    if (spec.left) {
+        std::memset(buffer + n, ' ', fill);
+    } else {
+        // Zeros go after the sign, and only in front of digits (not "inf" or "nan")
+        std::size_t sign = (buffer[0] == '-') ? 1 : 0;
+
+        if (spec.zero && isDigit(buffer[sign])) {
+            std::memmove(buffer + sign + fill, buffer + sign, n - sign);
+            std::memset(buffer + sign, '0', fill);
+        } else {
+            std::memmove(buffer + fill, buffer, n);
+            std::memset(buffer, ' ', fill);
+        }
+    }
+
+    buffer[spec.width] = 0;
+
+    return static_cast<int>(spec.width);
+} // pad
+
+template <typename T>
+struct IsInteger {
+    static const bool value = std::is_integral<T>::value && !std::is_same<T, bool>::value;
+};
+
+/*! \brief Type that an integer argument is converted to, as by printf
+ *
+ * \tparam L length modifier, see Spec
+ * \tparam T type of the argument, kept when there is no modifier
+ */
+template <char L, typename T>
+struct LengthType {
+    using Type = T;
+};
+
+template <typename T>
+struct LengthType<'H', T>{
+    using Type = signed char;
+};
+
+template <typename T>
+struct LengthType<'h', T>{
+    using Type = short;
+};
+
+template <typename T>
+struct LengthType<'l', T>{
+    using Type = long;
+};
+
+template <typename T>
+struct LengthType<'q', T>{
+    using Type = long long;
+};
+
+template <typename T>
+struct LengthType<'z', T>{
+    using Type = std::make_signed<std::size_t>::type;
+};
+
+template <typename T>
+struct LengthType<'j', T>{
+    using Type = intmax_t;
+};
+
+template <typename T>
+struct LengthType<'t', T>{
+    using Type = std::ptrdiff_t;
+};
+
+template <typename T>
+struct IsString {
+    static const bool value = std::is_convertible<const T&, const char*>::value;
+};
+
+/*! \brief Placeholder writer
+ *
+ * \tparam C conversion
+ */
+template <char C>
+struct Writer;
+
+template <>
+struct Writer<'d'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(IsInteger<T>::value, "%d and %i expect an integer argument");
+
+        int64_t v = static_cast<typename std::make_signed<typename LengthType<L, T>::Type>::type>(value);
+        return pad(buffer, length, NumberFormat::formatInt(buffer, length, v), spec);
+    }
+};
+
+template <>
+struct Writer<'i'>:
+    Writer<'d'>{};
+
+template <>
+struct Writer<'u'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(IsInteger<T>::value, "%u expects an integer argument");
+
+        uint64_t v = static_cast<typename std::make_unsigned<typename LengthType<L, T>::Type>::type>(value);
+        return pad(buffer, length, NumberFormat::formatUInt(buffer, length, v), spec);
+    }
+};
+
+template <>
+struct Writer<'x'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(IsInteger<T>::value, "%x and %X expect an integer argument");
+
+        uint64_t v = static_cast<typename std::make_unsigned<typename LengthType<L, T>::Type>::type>(value);
+
+        if (spec.zero && !spec.left) {
+            return NumberFormat::formatHex(buffer, length, v, spec.width, spec.conversion == 'X');
+        }
+
+        return pad(buffer, length, NumberFormat::formatHex(buffer, length, v, 0, spec.conversion == 'X'), spec);
+    }
+};
+
+template <>
+struct Writer<'X'>:
+    Writer<'x'>{};
+
+template <>
+struct Writer<'f'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(std::is_floating_point<T>::value, "%f expects a floating point argument");
+
+        unsigned precision = (spec.precision < 0) ? 6 : static_cast<unsigned>(spec.precision);
+        return pad(buffer, length, NumberFormat::formatFixed(buffer, length, value, precision), spec);
+    }
+};
+
+template <>
+struct Writer<'c'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(std::is_same<T, char>::value, "%c expects a char argument");
+
+        if (length < 2) {
+            return -1;
+        }
+
+        buffer[0] = value;
+        buffer[1] = 0;
+
+        return pad(buffer, length, 1, spec);
+    }
+};
+
+template <>
+struct Writer<'s'>{
+    template <char L, typename T>
+    static int
+    write(
+        char*       buffer,
+        std::size_t length,
+        const Spec& spec,
+        const T&    value
+    )
+    {
+        static_assert(IsString<T>::value, "%s expects a string argument");
+
+        const char* s = value;
+
+        if (s == nullptr) {
+            // As glibc does
+            s = ((spec.precision < 0) || (spec.precision >= 6)) ? "(null)" : "";
+        }
+
+        std::size_t n = 0;
+
+        if (spec.precision < 0) {
+            n = strlen(s);
+        } else {
+            while ((n < static_cast<std::size_t>(spec.precision)) && (s[n] != 0)) {
+                n++;
+            }
+        }
+
+        if (n >= length) {
+            return -1;
+        }
+
+        std::memcpy(buffer, s, n);
+        buffer[n] = 0;
+
+        return pad(buffer, length, static_cast<int>(n), spec);
+    }
+};
+
+template <typename F, std::size_t POS, typename ... ARGS>
+inline int
+write(
+    char*       buffer,
+    std::size_t length,
+    const ARGS& ... args
+);
+
+// End of the format string
+template <typename F, std::size_t POS, typename ... ARGS>
+inline int
+writePlaceholder(
+    std::integral_constant<int, 0>,
+    char*       buffer,
+    std::size_t length,
+    const ARGS& ...
+)
+{
+    if (length < 1) {
+        return -1;
+    }
+
+    buffer[0] = 0;
+
+    return 0;
+}
+
+// "%%"
+template <typename F, std::size_t POS, typename ... ARGS>
+inline int
+writePlaceholder(
+    std::integral_constant<int, 1>,
+    char*       buffer,
+    std::size_t length,
+    const ARGS& ... args
+)
+{
+    if (length < 2) {
+        return -1;
+    }
+
+    buffer[0] = '%';
+
+    int n = write<F, parse(F::str(), POS).end>(buffer + 1, length - 1, args ...);
+
+    return (n < 0) ? -1 : n + 1;
+}
+
+// Placeholder consuming an argument
+template <typename F, std::size_t POS, typename T, typename ... ARGS>
+inline int
+writePlaceholder(
+    std::integral_constant<int, 2>,
+    char*       buffer,
+    std::size_t length,
+    const T&    value,
+    const ARGS& ... args
+)
+{
+    constexpr Spec spec = parse(F::str(), POS);
+
+    int n = Writer<spec.conversion>::template write<spec.length>(buffer, length, spec, value);
+
+    if (n < 0) {
+        return -1;
+    }
+
+    int m = write<F, spec.end>(buffer + n, length - n, args ...);
+
+    return (m < 0) ? -1 : n + m;
+}
+
+/*! \brief Write the format string from \c POS on
+ *
+ * \return number of characters written (not including the \0), -1 if the buffer is not large enough
+ */
+template <typename F, std::size_t POS, typename ... ARGS>
+inline int
+write(
+    char*       buffer,
+    std::size_t length,
+    const ARGS& ... args
+)
+{
+    constexpr std::size_t PCT = next(F::str(), POS);
+    constexpr std::size_t LEN = PCT - POS;
+    constexpr char        C   = parse(F::str(), PCT).conversion;
+
+    if (LEN >= length) {
+        return -1;
+    }
+
+    std::memcpy(buffer, F::str() + POS, LEN);
+
+    int n = writePlaceholder<F, PCT>(std::integral_constant<int, (C == 0) ? 0 : (C == '%') ? 1 : 2>(), buffer + LEN, length - LEN, args ...);
+
+    return (n < 0) ? -1 : static_cast<int>(LEN) + n;
+}
+
+/*! \brief Type safe snprintf
+ *
+ * \return number of characters written (not including the \0), -1 if the buffer is not large enough
+ */
+template <typename F, typename ... ARGS>
+inline int
+format(
+    F,
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    const ARGS& ... args //!< [in] arguments
+)
+{
+    static_assert(isValid(F::str()), "Unsupported placeholder in format string");
+    static_assert(countArguments(F::str()) == sizeof ... (ARGS), "The number of arguments does not match the format string");
+
+    int n = write<F, 0>(buffer, length, args ...);
+
+    if ((n < 0) && (length > 0)) {
+        buffer[0] = 0;
+    }
+
+    return n;
+}
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,63 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief String hashing
+ *
+ * 64 bit FNV-1a: it is constexpr, so names known at compile time are hashed by the compiler,
+ * and the very same function hashes names known only at run time.
+ */
+namespace Hash {
+static const uint64_t FNV_OFFSET = 0xCBF29CE484222325u;
+static const uint64_t FNV_PRIME  = 0x00000100000001B3u;
+
+/*! \brief Hash of the first \c n characters of a string
+ *
+ */
+constexpr uint64_t
+string(
+    const char* s, //!< [in] string
+    std::size_t n, //!< [in] number of characters
+    uint64_t    seed = FNV_OFFSET //!< [in] starting value
+)
+{
+    uint64_t h = seed;
+
+    for (std::size_t i = 0; i < n; i++) {
+        h ^= static_cast<uint8_t>(s[i]);
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+/*! \brief Bit mixer
+ *
+ * Finalizer of splitmix64: every input bit affects every output bit,
+ * so any subset of the bits of the result can be used as an index.
+ */
+constexpr uint64_t
+mix(
+    uint64_t x //!< [in] value to mix
+)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9u;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBu;
+    x ^= x >> 31;
+
+    return x;
+}
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,537 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+#include <core/String.hpp>
+#include <core/ConstString.hpp>
+#include <core/CoreType.hpp>
+#include <core/StringBuffer.hpp>
+#include <core/Swar.hpp>
+
+#include <cmath>
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+namespace Json {
+/*! \brief Does a character need to be escaped in a JSON string?
+ *
+ */
+CORE_FORCE_INLINE bool
+needsEscape(
+    char c
+)
+{
+    return (c == '"') || (c == '\\') || (static_cast<uint8_t>(c) < 0x20);
+}
+
+/*! \brief Length of the run of characters that do not need escaping
+ *
+ * Scans one word at a time, so clean runs cost a few operations every 4 (or 8) bytes.
+ */
+inline std::size_t
+cleanRun(
+    const char* s,
+    std::size_t n
+)
+{
+    std::size_t i = 0;
+
+    for (; i + Swar::WORD_SIZE <= n; i += Swar::WORD_SIZE) {
+        Swar::Word w    = Swar::load(s + i);
+        Swar::Word mask = Swar::equalBytes(w, '"') | Swar::equalBytes(w, '\\') | Swar::lessBytes(w, 0x20);
+
+        if (mask != 0) {
+            return i + Swar::firstByte(mask);
+        }
+    }
+
+    while ((i < n) && !needsEscape(s[i])) {
+        i++;
+    }
+
+    return i;
+}
+
+/*! \brief Quoted and escaped JSON string
+ *
+ * Follows the snprintf conventions, as NumberFormat does.
+ * Bytes >= 0x80 are copied as they are, so UTF-8 input stays UTF-8.
+ *
+ * \return number of characters written (not including the \0), -1 if the buffer is not large enough
+ */
+inline int
+formatString(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    const char* s, //!< [in] string
+    std::size_t n //!< [in] length of the string
+)
+{
+    char*       out = buffer;
+    const char* end = buffer + length;
+
+    if ((end - out) < 3) {
+        if (length > 0) {
+            buffer[0] = 0;
+        }
+
+        return -1;
+    }
+
+    *out++ = '"';
+
+    for (;;) {
+        std::size_t run = cleanRun(s, n);
+
+        // +2: the closing quote and the \0
+        if (static_cast<std::size_t>(end - out) < run + 2) {
+            buffer[0] = 0;
+            return -1;
+        }
+
+        std::memcpy(out, s, run);
+        out += run;
+
+        if (run == n) {
+            break;
+        }
+
+        char        escape[6] = {'\\', 0, '0', '0', 0, 0};
+        std::size_t m         = 2;
+        const char  c         = s[run];
+
+        switch (c) {
+          case '"':  escape[1] = '"';
+              break;
+          case '\\': escape[1] = '\\';
+              break;
+          case '\b': escape[1] = 'b';
+              break;
+          case '\f': escape[1] = 'f';
+              break;
+          case '\n': escape[1] = 'n';
+              break;
+          case '\r': escape[1] = 'r';
+              break;
+          case '\t': escape[1] = 't';
+              break;
+          default:
+              escape[1] = 'u';
+              escape[4] = "0123456789abcdef"[(c >> 4) & 0x0F];
+              escape[5] = "0123456789abcdef"[c & 0x0F];
+              m         = 6;
+        }
+
+        if (static_cast<std::size_t>(end - out) < m + 2) {
+            buffer[0] = 0;
+            return -1;
+        }
+
+        std::memcpy(out, escape, m);
+        out += m;
+        s   += run + 1;
+        n   -= run + 1;
+    }
+
+    *out++ = '"';
+    *out   = 0;
+
+    return static_cast<int>(out - buffer);
+} // formatString
+}
+
+/*! \brief Streaming JSON writer
+ *
+ * core::JsonWriter writes JSON into a StringBuffer (or any StringWriter), taking care of separators and string escaping.
+ * Values are written according to their CoreType.
+ *
+ * \code
+ * core::StringBuffer<256> buffer;
+ * core::JsonWriter<>      json(buffer);
+ *
+ * json.beginObject();
+ * json.key("name");
+ * json.value(name);
+ * json.key("samples");
+ * json.value(samples); // core::Array<float, 16>
+ * json.endObject();
+ * \endcode
+ *
+ * Failures are sticky: once an append does not fit, ok() returns false.
+ *
+ * \tparam MAX_DEPTH maximum nesting of objects and arrays
+ */
+template <std::size_t MAX_DEPTH = 32>
+class JsonWriter
+{
+    static_assert(MAX_DEPTH <= 32, "MAX_DEPTH must be at most 32");
+
+public:
+    JsonWriter(
+        StringWriter& buffer
+    ) : _buffer(buffer), _depth(0), _first(0), _afterKey(false), _ok(true) {}
+
+    bool
+    beginObject()
+    {
+        return open('{');
+    }
+
+    bool
+    endObject()
+    {
+        return close('}');
+    }
+
+    bool
+    beginArray()
+    {
+        return open('[');
+    }
+
+    bool
+    endArray()
+    {
+        return close(']');
+    }
+
+    /*! \brief Write the key of the next object member
+     *
+     * A nullptr name is an error, as a failed append: nothing is written, and the writer stops.
+     */
+    bool
+    key(
+        const char* name
+    )
+    {
+        if (name == nullptr) {
+            return check(false);
+        }
+
+        separator();
+        check(appendJsonString(name, strlen(name)) && appendRaw(":", 1));
+        _afterKey = true;
+
+        return _ok;
+    }
+
+    /*! \brief Write a string, quoted and escaped
+     *
+     */
+    bool
+    appendJsonString(
+        const char* s,
+        std::size_t n
+    )
+    {
+        StringData data = {
+            s, n
+        };
+
+        return check(_buffer.appendFormatter(formatter, &data));
+    }
+
+    bool
+    valueNull()
+    {
+        separator();
+        return check(appendRaw("null", 4));
+    }
+
+    bool
+    value(
+        bool x
+    )
+    {
+        separator();
+        return check(x ? appendRaw("true", 4) : appendRaw("false", 5));
+    }
+
+    /*! \brief Write a CoreType::CHAR, as a one character string
+     *
+     */
+    bool
+    value(
+        char x
+    )
+    {
+        separator();
+        return appendJsonString(&x, 1);
+    }
+
+    /*! \brief Write an integer CoreType (INT8 .. UINT64)
+     *
+     */
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, bool>::type
+    value(
+        T x
+    )
+    {
+        separator();
+        return check(_buffer.appendInt(x));
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value, bool>::type
+    value(
+        T x
+    )
+    {
+        separator();
+        return check(_buffer.appendUInt(x));
+    }
+
+    /*! \brief Write a CoreType::FLOAT32
+     *
+     * The shortest text that reads back as the same float.
+     * Non finite values, that JSON cannot represent, are written as null.
+     */
+    bool
+    value(
+        float x
+    )
+    {
+        if (!std::isfinite(x)) {
+            return valueNull();
+        }
+
+        separator();
+        return check(_buffer.appendFloat(x));
+    }
+
+    /*! \brief Write a CoreType::FLOAT64
+     *
+     * The shortest text that reads back as the same double.
+     * Non finite values, that JSON cannot represent, are written as null.
+     */
+    bool
+    value(
+        double x
+    )
+    {
+        if (!std::isfinite(x)) {
+            return valueNull();
+        }
+
+        separator();
+        return check(_buffer.appendDouble(x));
+    }
+
+    bool
+    value(
+        const char* x
+    )
+    {
+        if (x == nullptr) {
+            return valueNull();
+        }
+
+        separator();
+        return appendJsonString(x, strlen(x));
+    }
+
+    template <std::size_t S>
+    bool
+    value(
+        const String<S>& x
+    )
+    {
+        separator();
+        return appendJsonString(x.data(), x.length());
+    }
+
+    template <std::size_t S>
+    bool
+    value(
+        const ConstString<S>& x
+    )
+    {
+        separator();
+        return appendJsonString(x.data(), x.length());
+    }
+
+    /*! \brief Write an array of CoreType values
+     *
+     */
+    template <typename T, std::size_t S>
+    bool
+    value(
+        const Array<T, S>& x
+    )
+    {
+        beginArray();
+
+        for (std::size_t i = 0; i < S; i++) {
+            value(x[i]);
+        }
+
+        return endArray();
+    }
+
+    /*! \brief Write a CoreType::VARIANT, according to its type
+     *
+     * Timestamps are written as null, as their representation is platform defined.
+     */
+    bool
+    value(
+        const CoreTypeTraitsHelperF<CoreType::VARIANT>::Type& x
+    )
+    {
+        switch (x.type) {
+          case CoreType::CHAR:    return value(x.c);
+
+          case CoreType::INT8:    return value(x.i8);
+
+          case CoreType::UINT8:   return value(x.u8);
+
+          case CoreType::INT16:   return value(x.i16);
+
+          case CoreType::UINT16:  return value(x.u16);
+
+          case CoreType::INT32:   return value(x.i32);
+
+          case CoreType::UINT32:  return value(x.u32);
+
+          case CoreType::INT64:   return value(x.i64);
+
+          case CoreType::UINT64:  return value(x.u64);
+
+          case CoreType::FLOAT32: return value(x.f32);
+
+          case CoreType::FLOAT64: return value(x.f64);
+
+          case CoreType::BOOL:    return value(x.boolean != 0);
+
+          default:                return valueNull();
+        }
+    }
+
+    /*! \brief Write a key and its value
+     *
+     */
+    template <typename T>
+    bool
+    member(
+        const char* name,
+        const T&    x
+    )
+    {
+        key(name);
+        return value(x);
+    }
+
+    /*! \brief Did all the appends succeed?
+     *
+     */
+    bool
+    ok() const
+    {
+        return _ok;
+    }
+
+private:
+    struct StringData {
+        const char* s;
+        std::size_t n;
+    };
+
+    static int
+    formatter(
+        char*       buffer,
+        std::size_t length,
+        const void* data
+    )
+    {
+        const StringData* string = static_cast<const StringData*>(data);
+
+        return Json::formatString(buffer, length, string->s, string->n);
+    }
+
+    // StringBuffer::appendString truncates silently, JSON cannot be truncated
+    bool
+    appendRaw(
+        const char* s,
+        std::size_t n
+    )
+    {
+        return (_buffer.free() >= n) && _buffer.appendString(s, n);
+    }
+
+    bool
+    check(
+        bool success
+    )
+    {
+        _ok = _ok && success;
+        return _ok;
+    }
+
+    // Write the comma before a value, if it is not the first one of its container
+    void
+    separator()
+    {
+        if (_afterKey) {
+            _afterKey = false;
+            return;
+        }
+
+        if (_depth > 0) {
+            const uint32_t bit = static_cast<uint32_t>(1) << (_depth - 1);
+
+            if (_first & bit) {
+                _first &= ~bit;
+            } else {
+                check(appendRaw(",", 1));
+            }
+        }
+    }
+
+    bool
+    open(
+        char c
+    )
+    {
+        separator();
+
+        if (_depth == MAX_DEPTH) {
+            return check(false);
+        }
+
+        _first |= static_cast<uint32_t>(1) << _depth;
+        _depth++;
+
+        return check(appendRaw(&c, 1));
+    }
+
+    bool
+    close(
+        char c
+    )
+    {
+        if (_depth == 0) {
+            return check(false);
+        }
+
+        _depth--;
+        _first &= ~(static_cast<uint32_t>(1) << _depth);
+
+        return check(appendRaw(&c, 1));
+    }
+
+    StringWriter& _buffer;
+    std::size_t   _depth;
+    uint32_t _first; // one bit per depth: the next value is the first of its container
+    bool     _afterKey;
+    bool     _ok;
+};
+
+NAMESPACE_CORE_END
@@ -0,0 +1,187 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+#include <core/PerfectHash.hpp>
+#include <core/StringLiteral.hpp>
+
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Name and ID pair
+ *
+ */
+template <typename ID>
+struct NameEntry {
+    StringLiteral name;
+    ID id = ID();
+};
+
+/*! \brief Constant name to ID and ID to name table
+ *
+ * Both directions are perfect hash indices (see PerfectHash) built by the compiler:
+ *
+ * \code
+ * static constexpr core::NameEntry<uint8_t> TOPICS[] = {
+ *     CORE_SYSTEM_TOPICS,
+ *     {"led", 0x10},
+ *     {"imu", 0x11}
+ * };
+ *
+ * static constexpr auto TOPIC_TABLE = core::makeNameTable(TOPICS);
+ *
+ * const core::NameEntry<uint8_t>* entry = TOPIC_TABLE.byName(name);
+ * \endcode
+ *
+ * A lookup hashes the name, reads the only entry that can match, and compares its hash and then its characters.
+ * Names and IDs must be unique: duplicates do not compile.
+ *
+ * \tparam N number of entries
+ * \tparam ID type of the IDs
+ */
+template <std::size_t N, typename ID = uint8_t>
+class NameTable
+{
+public:
+    using Entry = NameEntry<ID>;
+
+    constexpr
+    NameTable(
+        const Entry (&entries)[N] //!< [in] entries
+    ) : _entries(), _byName(PerfectHash<N>::make(nameKeys(entries).key)), _byId(PerfectHash<N>::make(idKeys(entries).key))
+    {
+        for (std::size_t i = 0; i < N; i++) {
+            _entries[i] = entries[i];
+        }
+    }
+
+    constexpr std::size_t
+    size() const
+    {
+        return N;
+    }
+
+    constexpr const Entry&
+    operator[](
+        std::size_t i
+    ) const
+    {
+        return _entries[i];
+    }
+
+    /*! \brief Find a name of known length
+     *
+     * \return the entry, nullptr if the name is not in the table
+     */
+    const Entry*
+    byName(
+        const char* name, //!< [in] name
+        std::size_t length //!< [in] its length
+    ) const
+    {
+        const uint64_t    hash = Hash::string(name, length);
+        const std::size_t i    = _byName.find(hash);
+
+        if ((i < N) && (_entries[i].name.hash() == hash) && _entries[i].name.equals(name, length)) {
+            return &_entries[i];
+        }
+
+        return nullptr;
+    }
+
+    /*! \brief Find a \0 terminated name
+     *
+     */
+    const Entry*
+    byName(
+        const char* name
+    ) const
+    {
+        return byName(name, std::strlen(name));
+    }
+
+    /*! \brief Find a name held in a String, ConstString, SizedString or StringLiteral
+     *
+     */
+    template <typename STRING>
+    typename std::enable_if<std::is_class<STRING>::value, const Entry*>::type
+    byName(
+        const STRING& name
+    ) const
+    {
+        return byName(name.data(), name.length());
+    }
+
+    /*! \brief Find an ID
+     *
+     * \return the entry, nullptr if the ID is not in the table
+     */
+    constexpr const Entry*
+    byId(
+        ID id
+    ) const
+    {
+        const std::size_t i = _byId.find(static_cast<uint64_t>(id));
+
+        return ((i < N) && (_entries[i].id == id)) ? &_entries[i] : nullptr;
+    }
+
+private:
+    struct Keys {
+        uint64_t key[N];
+    };
+
+    static constexpr Keys
+    nameKeys(
+        const Entry (&entries)[N]
+    )
+    {
+        Keys keys = {{0}};
+
+        for (std::size_t i = 0; i < N; i++) {
+            keys.key[i] = entries[i].name.hash();
+        }
+
+        return keys;
+    }
+
+    static constexpr Keys
+    idKeys(
+        const Entry (&entries)[N]
+    )
+    {
+        Keys keys = {{0}};
+
+        for (std::size_t i = 0; i < N; i++) {
+            keys.key[i] = static_cast<uint64_t>(entries[i].id);
+        }
+
+        return keys;
+    }
+
+    Entry _entries[N];
+    PerfectHash<N> _byName;
+    PerfectHash<N> _byId;
+};
+
+/*! \brief Build a NameTable, deducing its size and ID type
+ *
+ */
+template <typename ID, std::size_t N>
+constexpr NameTable<N, ID>
+makeNameTable(
+    const NameEntry<ID>(&entries)[N]
+)
+{
+    return NameTable<N, ID>(entries);
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,480 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+#include <core/StringView.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief NameTree
+ *
+ * core::NameTree is a radix (patricia) tree of hierarchical names, such as "node/topic/field",
+ * each with a value. Keys may be subscription patterns, whose levels can be wildcards:
+ * - \c + matches exactly one level: "imu/+/raw" matches "imu/0/raw";
+ * - \c # matches any number of levels, also none: "imu/#" matches "imu", "imu/0" and "imu/0/raw".
+ *
+ * \code
+ * core::NameTree<Handler*, 256, 4096> routes;
+ *
+ * routes.insert("imu/+/raw", &rawHandler);
+ * routes.match("imu/0/raw", [](Handler* h) { h->notify(); });
+ * \endcode
+ *
+ * Edges are labelled with strings, so each node is a branch point: a lookup visits at most one node per character,
+ * and its cost grows with the length of the name, not with the number of keys.
+ * Nodes and characters come from fixed size Array pools; there is no heap.
+ * Splitting an edge splits its label in place, so each character of a key is stored once.
+ *
+ * \tparam VALUE type of the values
+ * \tparam NODES size of the node pool: up to 2 nodes per key, plus the root
+ * \tparam CHARS size of the character pool
+ */
+template <typename VALUE, std::size_t NODES, std::size_t CHARS>
+class NameTree:
+    private core::Uncopyable
+{
+    static_assert(NODES >= 1, "NODES must be at least 1 (= the root)");
+    static_assert(NODES < 0xFFFF, "Nodes are indexed by 16 bits");
+
+    static const uint16_t NONE = 0xFFFF;
+    static const uint16_t ROOT = 0;
+
+public:
+    NameTree()
+    {
+        clear();
+    }
+
+    void
+    clear()
+    {
+        _nodes[ROOT] = Node();
+        _size = 1;
+        _used = 0;
+        _count = 0;
+    }
+
+    /*! \brief Number of keys
+     *
+     */
+    std::size_t
+    size() const
+    {
+        return _count;
+    }
+
+    /*! \brief Tell whether a key is a valid pattern
+     *
+     * \c + and \c # must be whole levels, and \c # must be the last one.
+     */
+    static bool
+    isValid(
+        const StringView& key
+    )
+    {
+        for (std::size_t i = 0; i < key.length(); i++) {
+            const char c = key[i];
+
+            if ((c != '+') && (c != '#')) {
+                continue;
+            }
+
+            const bool whole = ((i == 0) || (key[i - 1] == '/')) && ((i + 1 == key.length()) || (key[i + 1] == '/'));
+
+            if (!whole || ((c == '#') && (i + 1 != key.length()))) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /*! \brief Add a key, or replace its value
+     *
+     * Replacing the value of a key that is there never fails.
+     *
+     * \return false if the key is not valid, or there is no room for it; the tree is left as it was
+     */
+    bool
+    insert(
+        const StringView& key,
+        const VALUE&      value
+    )
+    {
+        if (!isValid(key) || (key.length() > 0xFFFF)) {
+            return false;
+        }
+
+        uint16_t    n = ROOT;
+        std::size_t p = 0;
+
+        while (p < key.length()) {
+            uint16_t* link = &_nodes[n].child;
+
+            // Children are sorted by their first character
+            while ((*link != NONE) && (first(*link) < key[p])) {
+                link = &_nodes[*link].sibling;
+            }
+
+            if ((*link == NONE) || (first(*link) != key[p])) {
+                if (!fits(1, key.length() - p)) {
+                    return false;
+                }
+
+                const uint16_t leaf = allocate(key.data() + p, key.length() - p);
+
+                _nodes[leaf].sibling = *link;
+                *link = leaf;
+                n     = leaf;
+                break;
+            }
+
+            const uint16_t    c     = *link;
+            const Node&       child = _nodes[c];
+            const std::size_t l     = common(child, key.data() + p, key.length() - p);
+
+            if (l < child.length) {
+                // A split is the last change but for the leaf with the rest of the key, if any: check for both
+                const std::size_t rest = key.length() - p - l;
+
+                if (!fits((rest > 0) ? 2 : 1, rest)) {
+                    return false;
+                }
+
+                // Split the edge: the new node takes the common part of the label
+                const uint16_t m = _size++;
+
+                _nodes[m]        = Node();
+                _nodes[m].label  = child.label;
+                _nodes[m].length = static_cast<uint16_t>(l);
+                _nodes[m].child  = c;
+                _nodes[m].sibling = child.sibling;
+
+                _nodes[c].label  += static_cast<uint32_t>(l);
+                _nodes[c].length -= static_cast<uint16_t>(l);
+                _nodes[c].sibling = NONE;
+
+                *link = m;
+            }
+
+            n  = *link;
+            p += l;
+        }
+
+        if (!_nodes[n].full) {
+            _nodes[n].full = true;
+            _count++;
+        }
+
+        _nodes[n].value = value;
+
+        return true;
+    } // insert
+
+    /*! \brief Value of a key
+     *
+     * The key is compared literally: wildcards only match themselves.
+     *
+     * \return pointer to the value, nullptr if the key is not there
+     */
+    const VALUE*
+    find(
+        const StringView& key
+    ) const
+    {
+        uint16_t    n = ROOT;
+        std::size_t p = 0;
+
+        while (p < key.length()) {
+            n = child(n, key[p]);
+
+            if (n == NONE) {
+                return nullptr;
+            }
+
+            const Node& node = _nodes[n];
+
+            if ((node.length > key.length() - p) || (std::memcmp(_chars.data() + node.label, key.data() + p, node.length) != 0)) {
+                return nullptr;
+            }
+
+            p += node.length;
+        }
+
+        return _nodes[n].full ? &_nodes[n].value : nullptr;
+    }
+
+    VALUE*
+    find(
+        const StringView& key
+    )
+    {
+        return const_cast<VALUE*>(static_cast<const NameTree*>(this)->find(key));
+    }
+
+    /*! \brief Visit the values of the keys that start with \c prefix
+     *
+     * The key is compared literally: wildcards only match themselves.
+     *
+     * \return number of visited values
+     */
+    template <typename F>
+    std::size_t
+    forEachPrefix(
+        const StringView& prefix,
+        F                 visitor //!< [in] called as visitor(const VALUE&)
+    ) const
+    {
+        uint16_t    n = ROOT;
+        std::size_t p = 0;
+
+        while (p < prefix.length()) {
+            n = child(n, prefix[p]);
+
+            if (n == NONE) {
+                return 0;
+            }
+
+            const Node&       node = _nodes[n];
+            const std::size_t l    = (node.length < prefix.length() - p) ? node.length : prefix.length() - p;
+
+            if (std::memcmp(_chars.data() + node.label, prefix.data() + p, l) != 0) {
+                return 0;
+            }
+
+            p += node.length;
+        }
+
+        return visit(n, visitor);
+    }
+
+    /*! \brief Visit the values of the keys that match a name
+     *
+     * \return number of visited values
+     */
+    template <typename F>
+    std::size_t
+    match(
+        const StringView& name,
+        F                 visitor //!< [in] called as visitor(const VALUE&)
+    ) const
+    {
+        return match(ROOT, name.data(), name.data() + name.length(), 0, visitor);
+    }
+
+private:
+    struct Node {
+        uint32_t label   = 0; //!< offset of the label in the character pool
+        uint16_t length  = 0; //!< length of the label
+        uint16_t child   = NONE; //!< first child
+        uint16_t sibling = NONE; //!< next sibling
+        bool     full    = false; //!< a key ends here
+        VALUE    value   = VALUE();
+    };
+
+    char
+    first(
+        uint16_t n
+    ) const
+    {
+        return _chars[_nodes[n].label];
+    }
+
+    uint16_t
+    child(
+        uint16_t n,
+        char     c
+    ) const
+    {
+        for (uint16_t x = _nodes[n].child; x != NONE; x = _nodes[x].sibling) {
+            if (first(x) == c) {
+                return x;
+            }
+        }
+
+        return NONE;
+    }
+
+    std::size_t
+    common(
+        const Node& node,
+        const char* s,
+        std::size_t n
+    ) const
+    {
+        const char* const label = _chars.data() + node.label;
+        const std::size_t m     = (node.length < n) ? node.length : n;
+        std::size_t       i     = 0;
+
+        while ((i < m) && (label[i] == s[i])) {
+            i++;
+        }
+
+        return i;
+    }
+
+    // Tell whether the pools have room for \c nodes more nodes and \c chars more characters
+    bool
+    fits(
+        std::size_t nodes,
+        std::size_t chars
+    ) const
+    {
+        return (_size + nodes <= NODES) && (_used + chars <= CHARS);
+    }
+
+    uint16_t
+    allocate(
+        const char* s,
+        std::size_t n
+    )
+    {
+        const uint16_t x = _size++;
+
+        _nodes[x]        = Node();
+        _nodes[x].label  = static_cast<uint32_t>(_used);
+        _nodes[x].length = static_cast<uint16_t>(n);
+
+        std::memcpy(_chars.data() + _used, s, n);
+        _used += n;
+
+        return x;
+    }
+
+    template <typename F>
+    std::size_t
+    visit(
+        uint16_t n,
+        F&       visitor
+    ) const
+    {
+        std::size_t count = 0;
+
+        if (_nodes[n].full) {
+            visitor(static_cast<const VALUE&>(_nodes[n].value));
+            count++;
+        }
+
+        for (uint16_t x = _nodes[n].child; x != NONE; x = _nodes[x].sibling) {
+            count += visit(x, visitor);
+        }
+
+        return count;
+    }
+
+    /*! \brief Match the rest of a name against the subtree of a node
+     *
+     * \param prev last key character before the label of the node, 0 at the root
+     */
+    template <typename F>
+    std::size_t
+    match(
+        uint16_t    n,
+        const char* p,
+        const char* end,
+        char        prev,
+        F&          visitor
+    ) const
+    {
+        const Node&       node  = _nodes[n];
+        const char* const label = _chars.data() + node.label;
+
+        for (std::size_t i = 0; i < node.length; i++) {
+            const char c          = label[i];
+            const bool levelStart = (prev == 0) || (prev == '/');
+
+            prev = c;
+
+            if (levelStart && (c == '+')) {
+                const void* slash = std::memchr(p, '/', static_cast<std::size_t>(end - p));
+
+                p = (slash != nullptr) ? static_cast<const char*>(slash) : end;
+                continue;
+            }
+
+            if (levelStart && (c == '#')) {
+                // Always the last character of a key
+                visitor(static_cast<const VALUE&>(node.value));
+                return 1;
+            }
+
+            if (p == end) {
+                // "a/#" matches "a" too
+                if (c != '/') {
+                    return 0;
+                }
+
+                if (i + 1 == node.length) {
+                    return matchParent(n, visitor);
+                }
+
+                if (label[i + 1] == '#') {
+                    visitor(static_cast<const VALUE&>(node.value));
+                    return 1;
+                }
+
+                return 0;
+            }
+
+            if (*p != c) {
+                return 0;
+            }
+
+            p++;
+        }
+
+        std::size_t count = 0;
+
+        if ((p == end) && node.full) {
+            visitor(static_cast<const VALUE&>(node.value));
+            count++;
+        }
+
+        const bool levelStart = (prev == 0) || (prev == '/');
+
+        for (uint16_t x = node.child; x != NONE; x = _nodes[x].sibling) {
+            const char c = first(x);
+
+            if (((p != end) && (*p == c)) || (levelStart && ((c == '+') || (c == '#'))) || ((p == end) && (c == '/'))) {
+                count += match(x, p, end, prev, visitor);
+            }
+        }
+
+        return count;
+    } // match
+
+    /*! \brief Visit the "#" child of a node whose label ends with '/'
+     *
+     */
+    template <typename F>
+    std::size_t
+    matchParent(
+        uint16_t n,
+        F&       visitor
+    ) const
+    {
+        for (uint16_t x = _nodes[n].child; x != NONE; x = _nodes[x].sibling) {
+            if (first(x) == '#') {
+                visitor(static_cast<const VALUE&>(_nodes[x].value));
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+
+    Array<Node, NODES> _nodes;
+    Array<char, CHARS> _chars;
+    std::size_t _size; //!< nodes in use
+    std::size_t _used; //!< characters in use
+    std::size_t _count; //!< keys
+};
+
+NAMESPACE_CORE_END
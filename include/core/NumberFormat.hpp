@@ -0,0 +1,435 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+
+#include <cstdio>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Number to text conversion
+ *
+ * The functions in this namespace follow the snprintf conventions:
+ * they write at most \c length characters (including the trailing \0) and return the number of
+ * characters written (not including the \0).
+ * Unlike snprintf, nothing is written if the result does not fit, and -1 is returned instead.
+ *
+ * The output is identical to the one of the equivalent printf conversion specifier.
+ */
+namespace NumberFormat {
+/*! \brief Two-digits lookup table
+ *
+ * \return pointer to the "00" .. "99" pairs
+ */
+inline const char*
+digitPairs()
+{
+    static const char pairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    return pairs;
+}
+
+/*! \brief Number of decimal digits of a value
+ *
+ */
+inline unsigned
+countDigits(
+    uint64_t value
+)
+{
+    unsigned n = 1;
+
+    for (;;) {
+        if (value < 10) {
+            return n;
+        }
+
+        if (value < 100) {
+            return n + 1;
+        }
+
+        if (value < 1000) {
+            return n + 2;
+        }
+
+        if (value < 10000) {
+            return n + 3;
+        }
+
+        value /= 10000;
+        n     += 4;
+    }
+}
+
+/*! \brief Write the decimal digits of a value backwards
+ *
+ * \return pointer to the first written character
+ */
+inline char*
+writeDigitsBackwards(
+    char*    end, //!< [in] one past the last character to be written
+    uint64_t value //!< [in] value
+)
+{
+    const char* pairs = digitPairs();
+
+    // 64 bit divisions are expensive on 32 bit targets, use them only when needed
+    while (value > 0xFFFFFFFFu) {
+        uint64_t q = value / 100;
+        unsigned r = static_cast<unsigned>(value - q * 100);
+        end  -= 2;
+        end[0] = pairs[2 * r];
+        end[1] = pairs[2 * r + 1];
+        value  = q;
+    }
+
+    uint32_t v = static_cast<uint32_t>(value);
+
+    while (v >= 100) {
+        uint32_t q = v / 100;
+        uint32_t r = v - q * 100;
+        end  -= 2;
+        end[0] = pairs[2 * r];
+        end[1] = pairs[2 * r + 1];
+        v      = q;
+    }
+
+    if (v >= 10) {
+        end   -= 2;
+        end[0] = pairs[2 * v];
+        end[1] = pairs[2 * v + 1];
+    } else {
+        *--end = static_cast<char>('0' + v);
+    }
+
+    return end;
+} // writeDigitsBackwards
+
+/*! \brief 64 x 64 -> 128 bit product
+ *
+ * Does not rely on __int128, that is not available on 32 bit targets.
+ *
+ * \return the low 64 bits of the product
+ */
+inline uint64_t
+multiply(
+    uint64_t  a, //!< [in] first factor
+    uint64_t  b, //!< [in] second factor
+    uint64_t& high //!< [out] high 64 bits of the product
+)
+{
+    const uint64_t aLo = a & 0xFFFFFFFFu;
+    const uint64_t aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFFu;
+    const uint64_t bHi = b >> 32;
+
+    const uint64_t b00 = aLo * bLo;
+    const uint64_t b01 = aLo * bHi;
+    const uint64_t b10 = aHi * bLo;
+    const uint64_t b11 = aHi * bHi;
+
+    const uint64_t mid1 = b10 + (b00 >> 32);
+    const uint64_t mid2 = b01 + (mid1 & 0xFFFFFFFFu);
+
+    high = b11 + (mid1 >> 32) + (mid2 >> 32);
+
+    return (mid2 << 32) | (b00 & 0xFFFFFFFFu);
+}
+
+/*! \brief Unsigned integer, as "%llu"
+ *
+ */
+inline int
+formatUInt(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    uint64_t    value //!< [in] value
+)
+{
+    std::size_t n = countDigits(value);
+
+    if (n >= length) {
+        return -1;
+    }
+
+    writeDigitsBackwards(buffer + n, value);
+    buffer[n] = 0;
+
+    return static_cast<int>(n);
+}
+
+/*! \brief Signed integer, as "%lld"
+ *
+ */
+inline int
+formatInt(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    int64_t     value //!< [in] value
+)
+{
+    if (value >= 0) {
+        return formatUInt(buffer, length, static_cast<uint64_t>(value));
+    }
+
+    // Negate as unsigned, INT64_MIN has no positive counterpart
+    uint64_t    u = ~static_cast<uint64_t>(value) + 1;
+    std::size_t n = countDigits(u) + 1;
+
+    if (n >= length) {
+        return -1;
+    }
+
+    buffer[0] = '-';
+    writeDigitsBackwards(buffer + n, u);
+    buffer[n] = 0;
+
+    return static_cast<int>(n);
+}
+
+/*! \brief Hexadecimal integer, as "%0*llx" (or "%0*llX")
+ *
+ */
+inline int
+formatHex(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    uint64_t    value, //!< [in] value
+    unsigned    width = 0, //!< [in] minimum number of digits, zero padded
+    bool        upper = false //!< [in] use uppercase digits
+)
+{
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::size_t n      = 1;
+
+    for (uint64_t v = value >> 4; v != 0; v >>= 4) {
+        n++;
+    }
+
+    if (n < width) {
+        n = width;
+    }
+
+    if (n >= length) {
+        return -1;
+    }
+
+    buffer[n] = 0;
+
+    for (std::size_t i = n; i > 0; i--) {
+        buffer[i - 1] = digits[value & 0x0F];
+        value       >>= 4;
+    }
+
+    return static_cast<int>(n);
+}
+
+/*! \brief Fixed point floating point, as "%.*f"
+ *
+ * Values whose exact binary expansion fits in 64 integer bits and 124 fractional bits
+ * (that is all the finite values from about 1e-21 to 1.8e19) are converted with integer arithmetic,
+ * rounding half to even as printf does.
+ * Everything else (huge, tiny, subnormal, inf and nan) is delegated to snprintf.
+ */
+inline int
+formatFixed(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    double      value, //!< [in] value
+    unsigned    precision = 6 //!< [in] number of fractional digits
+)
+{
+    static_assert(sizeof(double) == sizeof(uint64_t), "double must be an IEEE-754 binary64");
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const bool     negative = (bits >> 63) != 0;
+    const unsigned biased   = static_cast<unsigned>(bits >> 52) & 0x7FF;
+    uint64_t       mantissa = bits & ((static_cast<uint64_t>(1) << 52) - 1);
+    int exponent = 0;
+
+    // value = mantissa * 2^exponent
+    if (biased == 0x7FF || (biased == 0 && mantissa != 0)) {
+        goto fallback;
+    }
+
+    if (biased != 0) {
+        mantissa |= static_cast<uint64_t>(1) << 52;
+        exponent  = static_cast<int>(biased) - 1075;
+
+        while (((mantissa & 1) == 0) && (exponent < 0)) {
+            mantissa >>= 1;
+            exponent++;
+        }
+    }
+
+    {
+        uint64_t integer;
+        uint64_t hi = 0; // fractional part, binary point at bit 124 of hi:lo
+        uint64_t lo = 0;
+
+        if (exponent >= 0) {
+            if ((exponent > 11) || ((mantissa << exponent) >> exponent) != mantissa) {
+                goto fallback;
+            }
+
+            integer = mantissa << exponent;
+        } else {
+            const int shift = -exponent;
+
+            if (shift > 124) {
+                goto fallback;
+            }
+
+            integer = (shift < 64) ? (mantissa >> shift) : 0;
+            uint64_t fraction = (shift < 64) ? (mantissa & ((static_cast<uint64_t>(1) << shift) - 1)) : mantissa;
+            const int left    = 124 - shift; // fraction < 2^shift, align its binary point at bit 124
+
+            if (left >= 64) {
+                hi = fraction << (left - 64);
+            } else if (left > 0) {
+                hi = fraction >> (64 - left);
+                lo = fraction << left;
+            } else {
+                lo = fraction;
+            }
+        }
+
+        unsigned    intDigits = countDigits(integer);
+        std::size_t n         = (negative ? 1 : 0) + intDigits + (precision ? precision + 1 : 0);
+
+        if (n >= length) {
+            return -1;
+        }
+
+        // Fractional digits first, they decide the rounding of the integer part
+        char* frac = buffer + (n - precision);
+
+        for (unsigned i = 0; i < precision; i++) {
+            const uint64_t l0 = (lo & 0xFFFFFFFFu) * 10;
+            const uint64_t l1 = (lo >> 32) * 10 + (l0 >> 32);
+            lo      = (l1 << 32) | (l0 & 0xFFFFFFFFu);
+            hi      = hi * 10 + (l1 >> 32);
+            frac[i] = static_cast<char>('0' + (hi >> 60));
+            hi     &= (static_cast<uint64_t>(1) << 60) - 1;
+        }
+
+        const uint64_t half = static_cast<uint64_t>(1) << 59;
+        bool roundUp;
+
+        if ((hi > half) || ((hi == half) && (lo != 0))) {
+            roundUp = true;
+        } else if ((hi == half) && (lo == 0)) {
+            // Tie, round half to even
+            roundUp = precision ? ((frac[precision - 1] - '0') & 1) : (integer & 1);
+        } else {
+            roundUp = false;
+        }
+
+        if (roundUp) {
+            unsigned i = precision;
+
+            while (i > 0 && frac[i - 1] == '9') {
+                frac[--i] = '0';
+            }
+
+            if (i > 0) {
+                frac[i - 1]++;
+            } else {
+                integer++;
+
+                if (countDigits(integer) != intDigits) {
+                    // 99.96 -> 100.0, one more character
+                    if (++n >= length) {
+                        buffer[0] = 0;
+                        return -1;
+                    }
+
+                    intDigits++;
+
+                    if (precision) {
+                        std::memmove(frac + 1, frac, precision);
+                    }
+
+                    frac++;
+                }
+            }
+        }
+
+        char* p = buffer;
+
+        if (negative) {
+            *p++ = '-';
+        }
+
+        writeDigitsBackwards(p + intDigits, integer);
+
+        if (precision) {
+            p[intDigits] = '.';
+        }
+
+        buffer[n] = 0;
+
+        return static_cast<int>(n);
+    }
+
+fallback:
+    int n = snprintf(buffer, length, "%.*f", static_cast<int>(precision), value);
+
+    if ((n < 0) || (static_cast<std::size_t>(n) >= length)) {
+        if (length > 0) {
+            buffer[0] = 0;
+        }
+
+        return -1;
+    }
+
+    return n;
+} // formatFixed
+
+/*! \brief Shortest round-trip single precision floating point
+ *
+ * Writes the shortest decimal that reads back as the very same float (the closest one, if there are many),
+ * in fixed or scientific notation, whichever is shorter: "0.1", "100", "1e+21", "1.5e-07".
+ * The output is the one of std::to_chars(first, last, value), C++17; non finite values are written as "inf" and "nan".
+ * As there, an integer written in fixed notation has all of its exact digits: 190944592.f is "190944592", not "190944590".
+ *
+ * At most 15 characters are written (plus the \0). No printf, no heap: integer arithmetic only (Ryu).
+ */
+int
+formatShortest(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    float       value //!< [in] value
+);
+
+/*! \brief Shortest round-trip double precision floating point
+ *
+ * Same as the float version. At most 24 characters are written (plus the \0).
+ */
+int
+formatShortest(
+    char*       buffer, //!< [out] destination buffer
+    std::size_t length, //!< [in] length of the destination buffer
+    double      value //!< [in] value
+);
+}
+
+NAMESPACE_CORE_END
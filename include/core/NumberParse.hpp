@@ -0,0 +1,237 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/StringView.hpp>
+
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Text to number conversion
+ *
+ * The functions in this namespace follow the std::from_chars conventions (C++17):
+ * - they parse the longest prefix of [first, last) that is a number, with no leading whitespace and no '+';
+ * - they do not depend on the locale;
+ * - on success the value is stored, and the result points past the parsed characters;
+ * - if there is no number, the result points to \c first and its status is INVALID;
+ * - if the number does not fit the type, the result points past it and its status is OUT_OF_RANGE.
+ *
+ * In both failure cases the value is left untouched.
+ */
+namespace NumberParse {
+enum class Status {
+    OK, INVALID, OUT_OF_RANGE
+};
+
+struct Result {
+    const char* end; //!< first character that is not part of the number
+    Status      status;
+
+    bool
+    ok() const
+    {
+        return status == Status::OK;
+    }
+};
+
+/*! \brief Little endian load of 8 characters
+ *
+ */
+CORE_FORCE_INLINE uint64_t
+loadEight(
+    const char* p
+)
+{
+    uint64_t v;
+
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*! \brief Tell whether 8 characters are all decimal digits
+ *
+ * A byte is a digit if adding 0x46 does not carry into its high bit, and subtracting 0x30 does not borrow from it.
+ */
+CORE_FORCE_INLINE bool
+isEightDigits(
+    uint64_t v
+)
+{
+    return (((v + 0x4646464646464646u) | (v - 0x3030303030303030u)) & 0x8080808080808080u) == 0;
+}
+
+/*! \brief Value of 8 decimal digits
+ *
+ * Pairs, then quads, then the whole: three multiplications instead of eight.
+ *
+ * \pre isEightDigits(v), little endian
+ */
+CORE_FORCE_INLINE uint32_t
+parseEightDigits(
+    uint64_t v
+)
+{
+    const uint64_t mask = 0x000000FF000000FFu;
+    const uint64_t mul1 = 0x000F424000000064u; // 100 + (1000000 << 32)
+    const uint64_t mul2 = 0x0000271000000001u; // 1 + (10000 << 32)
+
+    v -= 0x3030303030303030u;
+    v  = (v * 10) + (v >> 8);
+    v  = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+
+    return static_cast<uint32_t>(v);
+}
+
+CORE_FORCE_INLINE bool
+isDigit(
+    char c
+)
+{
+    return static_cast<unsigned>(c - '0') < 10;
+}
+
+/*! \brief Parse a run of decimal digits as a 64 bit unsigned integer
+ *
+ * All the digits are consumed, also when their value does not fit.
+ *
+ * \return false if the value does not fit
+ */
+inline bool
+parseDigits(
+    const char*& p, //!< [in,out] first digit, then first character after the digits
+    const char*  last, //!< [in] end of the text
+    uint64_t&    value //!< [out] value
+)
+{
+    while ((p < last) && (*p == '0')) {
+        p++;
+    }
+
+    // Up to 19 significant digits cannot overflow
+    const char* const first = p;
+    uint64_t          v     = 0;
+
+    while ((last - p >= 8) && (p - first <= 11) && isEightDigits(loadEight(p))) {
+        v  = (v * 100000000u) + parseEightDigits(loadEight(p));
+        p += 8;
+    }
+
+    while ((p < last) && isDigit(*p) && (p - first < 19)) {
+        v = (v * 10) + static_cast<unsigned>(*p - '0');
+        p++;
+    }
+
+    bool fits = true;
+
+    if ((p < last) && isDigit(*p)) {
+        const uint64_t d = static_cast<unsigned>(*p - '0');
+
+        fits = (v < 1844674407370955161u) || ((v == 1844674407370955161u) && (d <= 5));
+        v    = (v * 10) + d;
+        p++;
+
+        // A 21st significant digit never fits
+        while ((p < last) && isDigit(*p)) {
+            fits = false;
+            p++;
+        }
+    }
+
+    value = v;
+
+    return fits;
+} // parseDigits
+
+/*! \brief Decimal integer, as std::from_chars(first, last, value)
+ *
+ * Signed types accept a leading '-'.
+ */
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, Result>::type
+parse(
+    const char* first, //!< [in] text
+    const char* last, //!< [in] end of the text
+    T&          value //!< [out] value
+)
+{
+    using U = typename std::make_unsigned<T>::type;
+
+    const char* p        = first;
+    const bool  negative = std::is_signed<T>::value && (p < last) && (*p == '-');
+
+    if (negative) {
+        p++;
+    }
+
+    if ((p == last) || !isDigit(*p)) {
+        return {first, Status::INVALID};
+    }
+
+    uint64_t       magnitude;
+    const bool     fits  = parseDigits(p, last, magnitude);
+    const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+
+    if (!fits || (magnitude > limit)) {
+        return {p, Status::OUT_OF_RANGE};
+    }
+
+    // Negate as unsigned, the most negative value has no positive counterpart
+    value = negative ? static_cast<T>(static_cast<U>(0) - static_cast<U>(magnitude)) : static_cast<T>(magnitude);
+
+    return {p, Status::OK};
+} // parse
+
+/*! \brief Single precision floating point, as std::from_chars(first, last, value)
+ *
+ * Accepts an optional '-', digits with an optional '.', and an optional exponent ("e-5");
+ * also "inf", "infinity" and "nan", case insensitive.
+ * The result is correctly rounded (to nearest, ties to even), whatever the number of digits.
+ * Values too large for the type are OUT_OF_RANGE; values too small become subnormals or zero.
+ *
+ * Most numbers are converted with one or two 64 x 128 bit products (Eisel-Lemire),
+ * with no printf, no locale and no heap. Numbers that are too close to the midpoint between two floats
+ * to tell with 19 digits are decided exactly, with big integer arithmetic on the stack.
+ */
+Result
+parse(
+    const char* first, //!< [in] text
+    const char* last, //!< [in] end of the text
+    float&      value //!< [out] value
+);
+
+/*! \brief Double precision floating point, as std::from_chars(first, last, value)
+ *
+ * Same as the float version.
+ */
+Result
+parse(
+    const char* first, //!< [in] text
+    const char* last, //!< [in] end of the text
+    double&     value //!< [out] value
+);
+
+/*! \brief Parse a String, ConstString, SizedString, StringBuffer or StringView
+ *
+ * \code
+ * NumberParse::parse(StringView(field), gain);
+ * \endcode
+ */
+template <typename T>
+inline Result
+parse(
+    const StringView& s, //!< [in] text
+    T&                value //!< [out] value
+)
+{
+    return parse(s.begin(), s.end(), value);
+}
+}
+
+NAMESPACE_CORE_END
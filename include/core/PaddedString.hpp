@@ -0,0 +1,350 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Swar.hpp>
+#include <core/String.hpp>
+#include <core/ConstString.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief PaddedString
+ *
+ * core::PaddedString is a core::String whose unused bytes are always zero.
+ * Every mutation keeps it that way, so two strings are equal exactly when their S bytes are:
+ * equality compares whole words with no branch per character (see Swar::equal),
+ * and ordering is a memcmp, that gives the same order as strcmp.
+ *
+ * As in core::String, a PaddedString<S> holds up to S characters, and it is not \0 terminated when full.
+ * It has the layout of a core::String<S>, and string() gives access to it as such.
+ *
+ * Mutations that do not fit truncate the result and return false.
+ *
+ * \tparam S size of the storage
+ */
+template <std::size_t S>
+class PaddedString
+{
+    static_assert(S >= 1, "S must be at least 1");
+
+public:
+    using size_type = std::size_t;
+
+    static const size_type SIZE = S;
+
+    PaddedString()
+    {
+        clear();
+    }
+
+    PaddedString(
+        const char* s
+    )
+    {
+        assign(s);
+    }
+
+    template <std::size_t S2>
+    PaddedString(
+        const String<S2>& s
+    )
+    {
+        assign(s);
+    }
+
+    template <std::size_t S2>
+    PaddedString(
+        const ConstString<S2>& s
+    )
+    {
+        assign(s);
+    }
+
+    constexpr size_type
+    size() const
+    {
+        return S;
+    }
+
+    size_type
+    length() const
+    {
+        return Swar::length(data(), S);
+    }
+
+    bool
+    empty() const
+    {
+        return _string._data[0] == 0;
+    }
+
+    const char*
+    data() const
+    {
+        return _string.data();
+    }
+
+    const char*
+    c_str() const
+    {
+        return _string.data();
+    }
+
+    /*! \brief The string, as a core::String
+     *
+     */
+    const String<S>&
+    string() const
+    {
+        return _string;
+    }
+
+    operator const char*() const {
+        return _string.data();
+    }
+
+    void
+    clear()
+    {
+        std::memset(_string._data, 0, S);
+    }
+
+    /*! \brief Fill the whole storage with \c c
+     *
+     * No byte is left for padding, unless \c c is \0.
+     */
+    void
+    fill(
+        char c
+    )
+    {
+        std::memset(_string._data, c, S);
+    }
+
+    bool
+    assign(
+        const char* s
+    )
+    {
+        if (s == nullptr) {
+            clear();
+            return false;
+        }
+
+        // One character more than what fits, to tell whether it gets truncated
+        const void*     end = memchr(s, 0, S + 1);
+        const size_type n   = (end != nullptr) ? static_cast<size_type>(static_cast<const char*>(end) - s) : S + 1;
+
+        copy(s, (n < S) ? n : S);
+
+        return n <= S;
+    }
+
+    /*! \brief Assign at most \c n characters
+     *
+     * Stops at the first \0, as StringBuffer::appendString does.
+     */
+    bool
+    assign(
+        const char* s,
+        size_type   n
+    )
+    {
+        if (s == nullptr) {
+            clear();
+            return false;
+        }
+
+        size_type   m   = (n < S) ? n : S;
+        const void* end = memchr(s, 0, m);
+
+        if (end != nullptr) {
+            m = static_cast<size_type>(static_cast<const char*>(end) - s);
+            n = m;
+        }
+
+        copy(s, m);
+
+        return m == n;
+    }
+
+    template <std::size_t S2>
+    bool
+    assign(
+        const String<S2>& s
+    )
+    {
+        return assign(s.data(), S2);
+    }
+
+    template <std::size_t S2>
+    bool
+    assign(
+        const ConstString<S2>& s
+    )
+    {
+        return assign(s.data(), S2);
+    }
+
+    PaddedString&
+    operator=(
+        const char* s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    template <std::size_t S2>
+    PaddedString&
+    operator=(
+        const String<S2>& s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    template <std::size_t S2>
+    PaddedString&
+    operator=(
+        const ConstString<S2>& s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    /*! \brief Three-way comparison
+     *
+     * \return <0, 0 or >0, as strcmp
+     */
+    int
+    compare(
+        const PaddedString& rhs
+    ) const
+    {
+        return std::memcmp(data(), rhs.data(), S);
+    }
+
+private:
+    void
+    copy(
+        const char* s,
+        size_type   n
+    )
+    {
+        std::memcpy(_string._data, s, n);
+        std::memset(_string._data + n, 0, S - n);
+    }
+
+    String<S> _string;
+};
+
+template <std::size_t S>
+inline bool
+operator==(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return Swar::equal(lhs.data(), rhs.data(), S);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator<(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+template <std::size_t S>
+inline bool
+operator>(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return lhs.compare(rhs) > 0;
+}
+
+template <std::size_t S>
+inline bool
+operator<=(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+template <std::size_t S>
+inline bool
+operator>=(
+    const PaddedString<S>& lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const PaddedString<S>& lhs,
+    const char*            rhs
+)
+{
+    return strncmp(rhs, lhs.data(), S) == 0;
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const char*            lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return rhs == lhs;
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const PaddedString<S>& lhs,
+    const char*            rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const char*            lhs,
+    const PaddedString<S>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+NAMESPACE_CORE_END
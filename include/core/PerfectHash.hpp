@@ -0,0 +1,160 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Perfect hash index
+ *
+ * Maps N distinct 64 bit keys to their positions [0, N) with no collisions,
+ * using the "hash and displace" scheme: keys are split into buckets, and each bucket gets
+ * the seed that places all of its keys into free slots. The biggest buckets are placed first, while the table is empty.
+ *
+ * The index is built by a constexpr function, so a table of constant keys is built by the compiler.
+ * A lookup costs two mixes and two table reads; it returns the only position that can hold the key,
+ * which the caller confirms with a single compare.
+ *
+ * \tparam N number of keys
+ */
+template <std::size_t N>
+struct PerfectHash {
+    static_assert(N > 0, "An index needs at least one key");
+    static_assert(N < 0x8000, "Positions are stored in 16 bits");
+
+    static const std::size_t BUCKETS = round_up_pow2(N); //!< about one key per bucket
+    static const std::size_t SLOTS   = 2 * BUCKETS; //!< at most half full, so that seeds are found quickly
+
+    static const uint16_t EMPTY    = 0xFFFF;
+    static const uint32_t MAX_SEED = 0xFFFF;
+
+    uint16_t seed[BUCKETS]; //!< displacement of each bucket
+    uint16_t slot[SLOTS]; //!< position of the key in each slot, EMPTY if none
+
+    static constexpr std::size_t
+    bucketOf(
+        uint64_t mixed
+    )
+    {
+        return static_cast<std::size_t>(mixed & (BUCKETS - 1));
+    }
+
+    static constexpr std::size_t
+    slotOf(
+        uint64_t mixed,
+        uint32_t displacement
+    )
+    {
+        return static_cast<std::size_t>(Hash::mix(mixed ^ (displacement * 0x9E3779B97F4A7C15u)) & (SLOTS - 1));
+    }
+
+    /*! \brief Position that can hold a key
+     *
+     * \return position of the key if it is one of the indexed keys, of another key or N otherwise
+     */
+    constexpr std::size_t
+    find(
+        uint64_t key
+    ) const
+    {
+        const uint64_t mixed    = Hash::mix(key);
+        const uint16_t position = slot[slotOf(mixed, seed[bucketOf(mixed)])];
+
+        return (position == EMPTY) ? N : position;
+    }
+
+    /*! \brief Build the index of a set of keys
+     *
+     * Keys must be distinct. Duplicated keys halt, which makes a constant expression fail to compile.
+     */
+    static constexpr PerfectHash
+    make(
+        const uint64_t (&keys)[N] //!< [in] keys
+    )
+    {
+        PerfectHash index = {{0}, {0}};
+        uint64_t    mixed[N] = {0};
+        uint16_t    count[BUCKETS] = {0};
+        uint16_t    start[BUCKETS + 1] = {0};
+        uint16_t    order[N] = {0};
+        std::size_t largest  = 0;
+
+        for (std::size_t i = 0; i < SLOTS; i++) {
+            index.slot[i] = EMPTY;
+        }
+
+        // Group the keys by bucket
+        for (std::size_t i = 0; i < N; i++) {
+            mixed[i] = Hash::mix(keys[i]);
+            count[bucketOf(mixed[i])]++;
+        }
+
+        for (std::size_t b = 0; b < BUCKETS; b++) {
+            start[b + 1] = static_cast<uint16_t>(start[b] + count[b]);
+            largest      = (count[b] > largest) ? count[b] : largest;
+            count[b]     = 0;
+        }
+
+        for (std::size_t i = 0; i < N; i++) {
+            const std::size_t b = bucketOf(mixed[i]);
+
+            order[start[b] + count[b]++] = static_cast<uint16_t>(i);
+        }
+
+        // Place the buckets, biggest first
+        for (std::size_t size = largest; size > 0; size--) {
+            for (std::size_t b = 0; b < BUCKETS; b++) {
+                if (count[b] != size) {
+                    continue;
+                }
+
+                const uint16_t* const bucket = order + start[b];
+
+                for (std::size_t j = 0; j < size; j++) {
+                    for (std::size_t k = 0; k < j; k++) {
+                        CORE_ENSURE_THAT(keys[bucket[j]] != keys[bucket[k]]);
+                    }
+                }
+
+                uint32_t s = 0;
+
+                for (;; s++) {
+                    CORE_ENSURE_THAT(s <= MAX_SEED);
+
+                    bool fits = true;
+
+                    for (std::size_t j = 0; fits && (j < size); j++) {
+                        const std::size_t x = slotOf(mixed[bucket[j]], s);
+
+                        fits = (index.slot[x] == EMPTY);
+
+                        for (std::size_t k = 0; fits && (k < j); k++) {
+                            fits = (slotOf(mixed[bucket[k]], s) != x);
+                        }
+                    }
+
+                    if (fits) {
+                        break;
+                    }
+                }
+
+                index.seed[b] = static_cast<uint16_t>(s);
+
+                for (std::size_t j = 0; j < size; j++) {
+                    index.slot[slotOf(mixed[bucket[j]], s)] = bucket[j];
+                }
+            }
+        }
+
+        return index;
+    } // make
+};
+
+NAMESPACE_CORE_END
@@ -0,0 +1,379 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief RingBuffer
+ *
+ * core::RingBuffer is a lock-free FIFO of up to N elements, between one producer and one consumer,
+ * e.g. an interrupt handler and a thread, or two threads: push and pop are wait-free, and take no lock.
+ *
+ * \code
+ * static core::RingBuffer<Sample, 256> samples;
+ *
+ * // ISR
+ * samples.push(adc.read());
+ *
+ * // Thread
+ * Sample batch[32];
+ * std::size_t n = samples.pop_n(batch, 32);
+ * \endcode
+ *
+ * Head and tail are free running counters, masked (with bit_mask) only to index the Array that holds the elements;
+ * so all the N slots are usable, and size() is tail - head.
+ * The producer publishes an element by storing the tail with release semantics, after writing it;
+ * the consumer frees a slot by storing the head, after reading it.
+ * Each side keeps a copy of the other side index, refreshed only when the buffer looks full (or empty):
+ * the counters, written by different cores, are CORE_CACHE_LINE_SIZE apart.
+ *
+ * \warning Exactly one producer and one consumer; see MpscRingBuffer for more producers.
+ *
+ * \tparam T type of the elements, default constructible and copyable
+ * \tparam N capacity, a power of 2
+ */
+template <typename T, std::size_t N>
+class RingBuffer:
+    private core::Uncopyable
+{
+    static_assert((N >= 2) && ((N & (N - 1)) == 0), "N must be a power of 2");
+
+    static const std::size_t MASK = bit_mask(log2_pow2(N));
+
+public:
+    RingBuffer()
+    {
+        _producer.tail.store(0, std::memory_order_relaxed);
+        _producer.head = 0;
+        _consumer.head.store(0, std::memory_order_relaxed);
+        _consumer.tail = 0;
+    }
+
+    constexpr std::size_t
+    capacity() const
+    {
+        return N;
+    }
+
+    /*! \brief Number of elements
+     *
+     * Exact when called by the producer or the consumer, a snapshot for anyone else.
+     */
+    std::size_t
+    size() const
+    {
+        const std::size_t head = _consumer.head.load(std::memory_order_acquire);
+
+        return _producer.tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    /*! \brief Add an element (producer)
+     *
+     * \return false if the buffer is full
+     */
+    bool
+    push(
+        const T& value
+    )
+    {
+        const std::size_t tail = _producer.tail.load(std::memory_order_relaxed);
+
+        if (tail - _producer.head == N) {
+            _producer.head = _consumer.head.load(std::memory_order_acquire);
+
+            if (tail - _producer.head == N) {
+                return false;
+            }
+        }
+
+        _buffer[tail & MASK] = value;
+        _producer.tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /*! \brief Add up to \c n elements (producer)
+     *
+     * The elements are copied in at most two chunks (memcpy for trivially copyable T), and published at once.
+     *
+     * \return the number of elements added, less than n if the buffer got full
+     */
+    std::size_t
+    push_n(
+        const T*    values,
+        std::size_t n
+    )
+    {
+        const std::size_t tail = _producer.tail.load(std::memory_order_relaxed);
+
+        if (N - (tail - _producer.head) < n) {
+            _producer.head = _consumer.head.load(std::memory_order_acquire);
+        }
+
+        const std::size_t free = N - (tail - _producer.head);
+
+        n = (n < free) ? n : free;
+
+        const std::size_t i     = tail & MASK;
+        const std::size_t first = (n < N - i) ? n : N - i;
+
+        ArrayOps::copy(_buffer.data() + i, values, first);
+        ArrayOps::copy(_buffer.data(), values + first, n - first);
+
+        _producer.tail.store(tail + n, std::memory_order_release);
+
+        return n;
+    }
+
+    /*! \brief Remove the oldest element (consumer)
+     *
+     * \return false if the buffer is empty
+     */
+    bool
+    pop(
+        T& value
+    )
+    {
+        const std::size_t head = _consumer.head.load(std::memory_order_relaxed);
+
+        if (head == _consumer.tail) {
+            _consumer.tail = _producer.tail.load(std::memory_order_acquire);
+
+            if (head == _consumer.tail) {
+                return false;
+            }
+        }
+
+        value = _buffer[head & MASK];
+        _consumer.head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /*! \brief Remove up to \c n elements (consumer)
+     *
+     * \return the number of elements removed, less than n if the buffer got empty
+     */
+    std::size_t
+    pop_n(
+        T*          values,
+        std::size_t n
+    )
+    {
+        const std::size_t head = _consumer.head.load(std::memory_order_relaxed);
+
+        if (_consumer.tail - head < n) {
+            _consumer.tail = _producer.tail.load(std::memory_order_acquire);
+        }
+
+        const std::size_t used = _consumer.tail - head;
+
+        n = (n < used) ? n : used;
+
+        const std::size_t i     = head & MASK;
+        const std::size_t first = (n < N - i) ? n : N - i;
+
+        ArrayOps::copy(values, _buffer.data() + i, first);
+        ArrayOps::copy(values + first, _buffer.data(), n - first);
+
+        _consumer.head.store(head + n, std::memory_order_release);
+
+        return n;
+    }
+
+private:
+    struct alignas(CORE_CACHE_LINE_SIZE) Producer {
+        std::atomic<std::size_t> tail; //!< next slot to write
+        std::size_t head; //!< last seen consumer head
+    };
+
+    struct alignas(CORE_CACHE_LINE_SIZE) Consumer {
+        std::atomic<std::size_t> head; //!< next slot to read
+        std::size_t tail; //!< last seen producer tail
+    };
+
+    Producer _producer;
+    Consumer _consumer;
+    alignas(CORE_CACHE_LINE_SIZE) alignas(T) Array<T, N> _buffer;
+};
+
+/*! \brief MpscRingBuffer
+ *
+ * core::MpscRingBuffer is a bounded lock-free FIFO of up to N elements, between any number of producers
+ * (threads, or interrupt handlers of any priority) and one consumer.
+ *
+ * Each slot has a sequence number, that tells who can use it (D. Vyukov, bounded MPMC queue):
+ * - it is \c p when the slot is free for the element at position \c p;
+ * - it is \c p + 1 when that element has been written, and can be read.
+ *
+ * Producers claim positions with a compare-and-swap on the tail, then write and publish their slots;
+ * push never waits for another producer, it retries only if one claimed the same position first.
+ * The consumer stops at the first slot that is not published yet, so an interrupted producer
+ * delays the elements after its own, but blocks no one.
+ *
+ * \warning It needs lock-free compare-and-swap: not available on Cortex-M0.
+ * \warning Exactly one consumer.
+ *
+ * \tparam T type of the elements, default constructible and copyable
+ * \tparam N capacity, a power of 2
+ */
+template <typename T, std::size_t N>
+class MpscRingBuffer:
+    private core::Uncopyable
+{
+    static_assert((N >= 2) && ((N & (N - 1)) == 0), "N must be a power of 2");
+
+    static const std::size_t MASK = bit_mask(log2_pow2(N));
+
+public:
+    MpscRingBuffer()
+    {
+        for (std::size_t i = 0; i < N; i++) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        _tail.store(0, std::memory_order_relaxed);
+        _head = 0;
+    }
+
+    constexpr std::size_t
+    capacity() const
+    {
+        return N;
+    }
+
+    /*! \brief Add an element (any producer)
+     *
+     * \return false if the buffer is full
+     */
+    bool
+    push(
+        const T& value
+    )
+    {
+        return push_n(&value, 1) == 1;
+    }
+
+    /*! \brief Add up to \c n elements (any producer)
+     *
+     * The elements get consecutive positions: those of different producers are not interleaved.
+     *
+     * \return the number of elements added, less than n if the buffer got full
+     */
+    std::size_t
+    push_n(
+        const T*    values,
+        std::size_t n
+    )
+    {
+        if (n == 0) {
+            return 0;
+        }
+
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+        std::size_t k;
+
+        for (;;) {
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(_slots[tail & MASK].sequence.load(std::memory_order_acquire) - tail);
+
+            if (diff < 0) {
+                // Not freed by the consumer yet: full
+                return 0;
+            }
+
+            if (diff > 0) {
+                // Claimed by another producer meanwhile
+                tail = _tail.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            // Slots are freed in order by the consumer: if the last one is free, so are the others
+            k = n;
+
+            while ((k > 1) && (_slots[(tail + k - 1) & MASK].sequence.load(std::memory_order_acquire) != tail + k - 1)) {
+                k--;
+            }
+
+            if (_tail.compare_exchange_weak(tail, tail + k, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < k; i++) {
+            Slot& slot = _slots[(tail + i) & MASK];
+
+            slot.value = values[i];
+            slot.sequence.store(tail + i + 1, std::memory_order_release);
+        }
+
+        return k;
+    }
+
+    /*! \brief Remove the oldest element (consumer)
+     *
+     * \return false if the buffer is empty, or the oldest element is still being written
+     */
+    bool
+    pop(
+        T& value
+    )
+    {
+        return pop_n(&value, 1) == 1;
+    }
+
+    /*! \brief Remove up to \c n elements (consumer)
+     *
+     * \return the number of elements removed, that stops at the first one still being written
+     */
+    std::size_t
+    pop_n(
+        T*          values,
+        std::size_t n
+    )
+    {
+        std::size_t i = 0;
+
+        for (; i < n; i++) {
+            Slot& slot = _slots[_head & MASK];
+
+            if (slot.sequence.load(std::memory_order_acquire) != _head + 1) {
+                break;
+            }
+
+            values[i] = slot.value;
+            slot.sequence.store(_head + N, std::memory_order_release);
+            _head++;
+        }
+
+        return i;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    alignas(CORE_CACHE_LINE_SIZE) std::atomic<std::size_t> _tail; //!< next position to claim
+    alignas(CORE_CACHE_LINE_SIZE) std::size_t _head; //!< next position to read
+    alignas(CORE_CACHE_LINE_SIZE) alignas(Slot) Array<Slot, N> _slots;
+};
+
+NAMESPACE_CORE_END
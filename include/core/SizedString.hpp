@@ -0,0 +1,469 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/String.hpp>
+#include <core/ConstString.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief SizedString
+ *
+ * core::SizedString is a core::String that keeps track of its length, so that length() costs nothing.
+ * The length is updated by every mutation; comparisons check it before looking at the characters.
+ *
+ * As in StringBuffer, the storage includes the trailing \0, that is always there:
+ * a SizedString<S> holds at most S - 1 characters, and string() is a valid core::String<S>.
+ *
+ * Mutations that do not fit truncate the result and return false.
+ *
+ * \tparam S size of the storage, the trailing \0 included
+ */
+template <std::size_t S>
+class SizedString
+{
+    static_assert(S >= 1, "S must be at least 1 (= the trailing 0)");
+
+public:
+    using size_type = std::size_t;
+
+    static const size_type SIZE = S;
+
+    SizedString() : _length(0)
+    {
+        _string.clear();
+    }
+
+    SizedString(
+        const char* s
+    ) : _length(0)
+    {
+        assign(s);
+    }
+
+    template <std::size_t S2>
+    SizedString(
+        const String<S2>& s
+    ) : _length(0)
+    {
+        assign(s);
+    }
+
+    template <std::size_t S2>
+    SizedString(
+        const ConstString<S2>& s
+    ) : _length(0)
+    {
+        assign(s);
+    }
+
+    /*! \brief Get the size of the storage
+     *
+     */
+    constexpr size_type
+    size() const
+    {
+        return S;
+    }
+
+    /*! \brief Maximum length of the string
+     *
+     */
+    constexpr size_type
+    capacity() const
+    {
+        return S - 1;
+    }
+
+    size_type
+    length() const
+    {
+        return _length;
+    }
+
+    bool
+    empty() const
+    {
+        return _length == 0;
+    }
+
+    const char*
+    data() const
+    {
+        return _string.data();
+    }
+
+    const char*
+    c_str() const
+    {
+        return _string.data();
+    }
+
+    /*! \brief The string, as a core::String
+     *
+     */
+    const String<S>&
+    string() const
+    {
+        return _string;
+    }
+
+    operator const char*() const {
+        return _string.data();
+    }
+
+    void
+    clear()
+    {
+        _length = 0;
+        _string._data[0] = 0;
+    }
+
+    /*! \brief Shorten the string to \c n characters
+     *
+     */
+    void
+    truncate(
+        size_type n
+    )
+    {
+        if (n < _length) {
+            _length = n;
+            _string._data[n] = 0;
+        }
+    }
+
+    bool
+    assign(
+        const char* s
+    )
+    {
+        clear();
+        return append(s);
+    }
+
+    /*! \brief Assign at most \c n characters
+     *
+     * Stops at the first \0, as StringBuffer::appendString does.
+     */
+    bool
+    assign(
+        const char* s,
+        size_type   n
+    )
+    {
+        clear();
+        return append(s, n);
+    }
+
+    template <std::size_t S2>
+    bool
+    assign(
+        const String<S2>& s
+    )
+    {
+        clear();
+        return append(s.data(), S2);
+    }
+
+    template <std::size_t S2>
+    bool
+    assign(
+        const ConstString<S2>& s
+    )
+    {
+        clear();
+        return append(s.data(), S2);
+    }
+
+    template <std::size_t S2>
+    bool
+    assign(
+        const SizedString<S2>& s
+    )
+    {
+        clear();
+        return append(s);
+    }
+
+    bool
+    append(
+        char c
+    )
+    {
+        if (_length >= S - 1) {
+            return false;
+        }
+
+        _string._data[_length++] = c;
+        _string._data[_length]   = 0;
+
+        return true;
+    }
+
+    bool
+    append(
+        const char* s
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        // One character more than what fits, to tell whether it gets truncated
+        const size_type available = S - 1 - _length;
+        const void*     end       = memchr(s, 0, available + 1);
+        const size_type n         = (end != nullptr) ? static_cast<size_type>(static_cast<const char*>(end) - s) : available + 1;
+        const size_type m         = (n < available) ? n : available;
+
+        copy(s, m);
+
+        return m == n;
+    }
+
+    bool
+    append(
+        const char* s,
+        size_type   n
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        const size_type available = S - 1 - _length;
+        size_type       m         = (n < available) ? n : available;
+        const void*     end       = memchr(s, 0, m);
+
+        if (end != nullptr) {
+            m = static_cast<const char*>(end) - s;
+            n = m;
+        }
+
+        copy(s, m);
+
+        return m == n;
+    }
+
+    template <std::size_t S2>
+    bool
+    append(
+        const SizedString<S2>& s
+    )
+    {
+        const size_type available = S - 1 - _length;
+        const size_type m         = (s.length() < available) ? s.length() : available;
+
+        copy(s.data(), m);
+
+        return m == s.length();
+    }
+
+    SizedString&
+    operator=(
+        const char* s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    template <std::size_t S2>
+    SizedString&
+    operator=(
+        const String<S2>& s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    template <std::size_t S2>
+    SizedString&
+    operator=(
+        const ConstString<S2>& s
+    )
+    {
+        assign(s);
+        return *this;
+    }
+
+    template <typename T>
+    SizedString&
+    operator+=(
+        const T& x
+    )
+    {
+        append(x);
+        return *this;
+    }
+
+private:
+    void
+    copy(
+        const char* s,
+        size_type   n
+    )
+    {
+        std::memcpy(_string._data + _length, s, n);
+        _length += n;
+        _string._data[_length] = 0;
+    }
+
+    String<S> _string;
+    size_type _length;
+};
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator==(
+    const SizedString<S1>& lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return (lhs.length() == rhs.length()) && (std::memcmp(lhs.data(), rhs.data(), lhs.length()) == 0);
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator!=(
+    const SizedString<S1>& lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator==(
+    const SizedString<S1>& lhs,
+    const String<S2>&      rhs
+)
+{
+    const std::size_t n = lhs.length();
+
+    // A String of S2 characters has no \0
+    return (n <= S2) && (std::memcmp(rhs.data(), lhs.data(), n) == 0) && ((n == S2) || (rhs.data()[n] == 0));
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator==(
+    const String<S1>&      lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return rhs == lhs;
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator!=(
+    const SizedString<S1>& lhs,
+    const String<S2>&      rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator!=(
+    const String<S1>&      lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator==(
+    const SizedString<S1>& lhs,
+    const ConstString<S2>& rhs
+)
+{
+    const std::size_t n = lhs.length();
+
+    // strncmp, not memcmp: the literal pointed by a ConstString may be shorter than S2
+    return (n <= S2) && (std::strncmp(rhs.data(), lhs.data(), n) == 0) && ((n == S2) || (rhs.data()[n] == 0));
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator==(
+    const ConstString<S1>& lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return rhs == lhs;
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator!=(
+    const SizedString<S1>& lhs,
+    const ConstString<S2>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S1, std::size_t S2>
+inline bool
+operator!=(
+    const ConstString<S1>& lhs,
+    const SizedString<S2>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const SizedString<S>& lhs,
+    const char*           rhs
+)
+{
+    return (std::strncmp(rhs, lhs.data(), lhs.length()) == 0) && (rhs[lhs.length()] == 0);
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const char*           lhs,
+    const SizedString<S>& rhs
+)
+{
+    return rhs == lhs;
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const SizedString<S>& lhs,
+    const char*           rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const char*           lhs,
+    const SizedString<S>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,444 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+#include <core/ConstArray.hpp>
+#include <core/String.hpp>
+
+#include <iterator>
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Span
+ *
+ * core::Span is a view of elements owned by someone else: a pointer, a length known at run time, and a stride.
+ * Taking a part of it, or every k-th element, gives another view: nothing is copied.
+ *
+ * \code
+ * core::Array<float, 2 * N> stereo;            // L R L R ...
+ *
+ * core::Span<const float> left  = core::Span<const float>(stereo).strided(2);
+ * core::Span<const float> right = core::Span<const float>(stereo).subspan(1).strided(2);
+ *
+ * filter(left.first(16));                      // the first 16 samples of the left channel
+ * \endcode
+ *
+ * The stride is in elements: element i is at data()[i * stride()]. A contiguous span has stride 1.
+ * No pointer is ever formed past the last element (plus one), so the iterators compare by index.
+ *
+ * It is built from an Array, a ConstArray, a String (all its S characters), a C array, or a pointer and a length.
+ * Use Span<const T> for read-only views; a Span<T> converts to a Span<const T>.
+ *
+ * \warning The span must not outlive the elements it refers to.
+ *
+ * \tparam T type of the elements, const for read-only views
+ */
+template <typename T>
+class Span
+{
+    // U* converts to T* by adding const only, as in std::span
+    template <typename U>
+    using EnableIfCompatible = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type;
+
+public:
+    using element_type    = T;
+    using value_type      = typename std::remove_cv<T>::type;
+    using pointer         = T *;
+    using reference       = T &;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static const size_type NPOS = static_cast<size_type>(-1); //!< "up to the end"
+
+    /*! \brief Random access iterator, that steps by the stride
+     *
+     * It holds the first element and an index: with a stride, a pointer to the end would be past one-past-the-end.
+     */
+    class Iterator
+    {
+public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename Span::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = T *;
+        using reference         = T &;
+
+        Iterator() : _base(nullptr), _index(0), _stride(1) {}
+
+        Iterator(
+            T*              base,
+            difference_type index,
+            size_type       stride
+        ) : _base(base), _index(index), _stride(static_cast<difference_type>(stride)) {}
+
+        reference
+        operator*() const
+        {
+            return _base[_index * _stride];
+        }
+
+        pointer
+        operator->() const
+        {
+            return _base + _index * _stride;
+        }
+
+        reference
+        operator[](
+            difference_type n
+        ) const
+        {
+            return _base[(_index + n) * _stride];
+        }
+
+        Iterator&
+        operator++()
+        {
+            _index++;
+            return *this;
+        }
+
+        Iterator
+        operator++(
+            int
+        )
+        {
+            Iterator i = *this;
+
+            _index++;
+            return i;
+        }
+
+        Iterator&
+        operator--()
+        {
+            _index--;
+            return *this;
+        }
+
+        Iterator
+        operator--(
+            int
+        )
+        {
+            Iterator i = *this;
+
+            _index--;
+            return i;
+        }
+
+        Iterator&
+        operator+=(
+            difference_type n
+        )
+        {
+            _index += n;
+            return *this;
+        }
+
+        Iterator&
+        operator-=(
+            difference_type n
+        )
+        {
+            _index -= n;
+            return *this;
+        }
+
+        Iterator
+        operator+(
+            difference_type n
+        ) const
+        {
+            return Iterator(_base, _index + n, static_cast<size_type>(_stride));
+        }
+
+        Iterator
+        operator-(
+            difference_type n
+        ) const
+        {
+            return Iterator(_base, _index - n, static_cast<size_type>(_stride));
+        }
+
+        difference_type
+        operator-(
+            const Iterator& rhs
+        ) const
+        {
+            return _index - rhs._index;
+        }
+
+        bool
+        operator==(
+            const Iterator& rhs
+        ) const
+        {
+            return _index == rhs._index;
+        }
+
+        bool
+        operator!=(
+            const Iterator& rhs
+        ) const
+        {
+            return _index != rhs._index;
+        }
+
+        bool
+        operator<(
+            const Iterator& rhs
+        ) const
+        {
+            return _index < rhs._index;
+        }
+
+        bool
+        operator>(
+            const Iterator& rhs
+        ) const
+        {
+            return rhs < *this;
+        }
+
+        bool
+        operator<=(
+            const Iterator& rhs
+        ) const
+        {
+            return !(rhs < *this);
+        }
+
+        bool
+        operator>=(
+            const Iterator& rhs
+        ) const
+        {
+            return !(*this < rhs);
+        }
+
+private:
+        T* _base; //!< first element of the span
+        difference_type _index;
+        difference_type _stride;
+    };
+
+    using iterator = Iterator;
+
+    constexpr
+    Span() : _data(nullptr), _size(0), _stride(1) {}
+
+    /*! \brief View of \c n elements, \c stride elements apart
+     *
+     * \pre stride >= 1
+     */
+    constexpr
+    Span(
+        T*        data, //!< [in] first element
+        size_type n, //!< [in] number of elements
+        size_type stride = 1 //!< [in] distance between two elements, in elements
+    ) : _data(data), _size(n), _stride(stride) {}
+
+    template <typename U, std::size_t N, typename = EnableIfCompatible<U> >
+    constexpr
+    Span(
+        U(&a)[N]
+    ) : _data(a), _size(N), _stride(1) {}
+
+    template <typename U, std::size_t S, typename = EnableIfCompatible<U> >
+    Span(
+        Array<U, S>& a
+    ) : _data(a.data()), _size(S), _stride(1) {}
+
+    template <typename U, std::size_t S, typename = EnableIfCompatible<const U> >
+    Span(
+        const Array<U, S>& a
+    ) : _data(a.data()), _size(S), _stride(1) {}
+
+    template <typename U, std::size_t S, typename = EnableIfCompatible<const U> >
+    Span(
+        const ConstArray<U, S>& a
+    ) : _data(a.data()), _size(S), _stride(1) {}
+
+    template <std::size_t S, typename C = char, typename = EnableIfCompatible<C> >
+    Span(
+        String<S>& s
+    ) : _data(s.data()), _size(S), _stride(1) {}
+
+    template <std::size_t S, typename C = const char, typename = EnableIfCompatible<C> >
+    Span(
+        const String<S>& s
+    ) : _data(s.data()), _size(S), _stride(1) {}
+
+    /*! \brief Conversion from Span<U>, e.g. from Span<T> to Span<const T>
+     *
+     */
+    template <typename U, typename = EnableIfCompatible<U> >
+    constexpr
+    Span(
+        const Span<U>& s
+    ) : _data(s.data()), _size(s.size()), _stride(s.stride()) {}
+
+    constexpr pointer
+    data() const
+    {
+        return _data;
+    }
+
+    constexpr size_type
+    size() const
+    {
+        return _size;
+    }
+
+    constexpr size_type
+    length() const
+    {
+        return _size;
+    }
+
+    constexpr bool
+    empty() const
+    {
+        return _size == 0;
+    }
+
+    /*! \brief Distance between two elements, in elements
+     *
+     */
+    constexpr size_type
+    stride() const
+    {
+        return _stride;
+    }
+
+    /*! \brief Tell whether the elements are adjacent, so that data() can be used as a C array
+     *
+     */
+    constexpr bool
+    isContiguous() const
+    {
+        return (_stride == 1) || (_size <= 1);
+    }
+
+    /*! \brief Element access
+     *
+     * \return a reference to element at index \c n
+     */
+    constexpr reference
+    operator[](
+        size_type n //!< [in] index
+    ) const
+    {
+        return _data[n * _stride];
+    }
+
+    /*! \brief Element access (with range check)
+     *
+     * \pre \c n must index a valid object
+     *
+     * \return a reference to element at index \c n
+     */
+    reference
+    at(
+        size_type n //!< [in] index
+    ) const
+    {
+        CORE_ASSERT(n < _size);
+
+        return _data[n * _stride];
+    }
+
+    reference
+    front() const
+    {
+        return _data[0];
+    }
+
+    reference
+    back() const
+    {
+        return _data[(_size - 1) * _stride];
+    }
+
+    Iterator
+    begin() const
+    {
+        return Iterator(_data, 0, _stride);
+    }
+
+    Iterator
+    end() const
+    {
+        return Iterator(_data, static_cast<difference_type>(_size), _stride);
+    }
+
+    /*! \brief Part of the span
+     *
+     * \return the (at most) \c n elements from \c offset, empty if \c offset is past the end
+     */
+    Span
+    subspan(
+        size_type offset,
+        size_type n = NPOS
+    ) const
+    {
+        if (offset >= _size) {
+            // Not _data + _size * _stride: with a stride, that is past one-past-the-end
+            return Span(_data, 0, _stride);
+        }
+
+        return Span(_data + offset * _stride, (n < _size - offset) ? n : _size - offset, _stride);
+    }
+
+    /*! \brief The (at most) \c n first elements
+     *
+     */
+    Span
+    first(
+        size_type n
+    ) const
+    {
+        return Span(_data, (n < _size) ? n : _size, _stride);
+    }
+
+    /*! \brief The (at most) \c n last elements
+     *
+     */
+    Span
+    last(
+        size_type n
+    ) const
+    {
+        return (n < _size) ? subspan(_size - n) : *this;
+    }
+
+    /*! \brief Every \c k-th element, starting from the first one
+     *
+     * \pre k >= 1
+     */
+    Span
+    strided(
+        size_type k
+    ) const
+    {
+        CORE_ASSERT(k >= 1);
+
+        return Span(_data, (_size + k - 1) / k, _stride * k);
+    }
+
+private:
+    T*        _data;
+    size_type _size;
+    size_type _stride;
+};
+
+NAMESPACE_CORE_END
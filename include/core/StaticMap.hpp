@@ -0,0 +1,558 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+#include <core/Swar.hpp>
+#include <core/StringView.hpp>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief How StaticMap hashes and compares keys
+ *
+ * hash(q) and equal(key, q) must accept the key type, and any type that lookups are made with:
+ * hash(q) must then be the hash of the key that is equal to q.
+ * The hash does not need to be well distributed: StaticMap mixes it (see Hash::mix).
+ *
+ * Integers and enums are hashed by value, pointers by address.
+ */
+template <typename K, typename = void>
+struct StaticMapTraits {};
+
+template <typename K>
+struct StaticMapTraits<K, typename std::enable_if<std::is_integral<K>::value || std::is_enum<K>::value>::type> {
+    static uint64_t
+    hash(
+        K key
+    )
+    {
+        return static_cast<uint64_t>(key);
+    }
+
+    static bool
+    equal(
+        K lhs,
+        K rhs
+    )
+    {
+        return lhs == rhs;
+    }
+};
+
+template <typename K>
+struct StaticMapTraits<K*> {
+    static uint64_t
+    hash(
+        const K* key
+    )
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(key));
+    }
+
+    static bool
+    equal(
+        const K* lhs,
+        const K* rhs
+    )
+    {
+        return lhs == rhs;
+    }
+};
+
+/*! \brief Strings are hashed and compared by their characters
+ *
+ * As StringView: so a map with String keys can be searched with a ConstString, a const char*, a StringBuffer, ...
+ */
+struct StaticMapStringTraits {
+    static uint64_t
+    hash(
+        const StringView& key
+    )
+    {
+        return key.hash();
+    }
+
+    static bool
+    equal(
+        const StringView& lhs,
+        const StringView& rhs
+    )
+    {
+        return lhs.equals(rhs);
+    }
+};
+
+template <std::size_t S>
+struct StaticMapTraits<String<S> >:
+    StaticMapStringTraits {};
+
+template <std::size_t S>
+struct StaticMapTraits<ConstString<S> >:
+    StaticMapStringTraits {};
+
+template <>
+struct StaticMapTraits<StringView>:
+    StaticMapStringTraits {};
+
+/*! \brief StaticMap
+ *
+ * core::StaticMap is a hash map with a fixed capacity and no heap: up to N key-value pairs,
+ * in storage that is part of the object.
+ *
+ * \code
+ * core::StaticMap<core::String<16>, Parameter*, 64> parameters;
+ *
+ * parameters.insert(p.name, &p);
+ * ...
+ * Parameter** p = parameters.find("gain");   // nullptr if there is none
+ * \endcode
+ *
+ * It is an open addressing table with Robin Hood linear probing:
+ * entries are kept in order of distance from their home slot, so a lookup stops as soon as it reaches an entry
+ * closer to home than the key would be, and a missing key costs about as much as a present one.
+ * Erasing shifts the following entries of the run back by one slot: there are no tombstones,
+ * and the table does not degrade with insertions and erasures.
+ *
+ * Each slot has two metadata bytes, in arrays of their own: the distance from home plus one (0 when empty),
+ * and 8 bits of the hash. A lookup tests a word of slots at a time (Swar), and compares the keys only of the
+ * slots whose hash bits match, within the run that can hold the key: with strings as keys,
+ * almost all the character compares are of the key that is found.
+ * The metadata arrays repeat their first word after the end, so that a word can be read across the wrap.
+ *
+ * The table has round_up_pow2(N + N / 16) slots, at least a word, so the load factor is at most about 94%.
+ * Distances are limited to MAX_DISTANCE, far beyond what a load below 95% produces
+ * unless many keys have the same hash; an insertion that would exceed it fails.
+ *
+ * Only the slots in use are constructed: K and V do not need a default constructor.
+ *
+ * \tparam K type of the keys
+ * \tparam V type of the values
+ * \tparam N capacity
+ * \tparam TRAITS how keys are hashed and compared, see StaticMapTraits
+ */
+template <typename K, typename V, std::size_t N, typename TRAITS = StaticMapTraits<K> >
+class StaticMap
+{
+    static_assert(N >= 1, "N must be at least 1");
+
+    using Word = Swar::Word;
+
+    static const std::size_t W     = Swar::WORD_SIZE;
+    static const std::size_t SLOTS = (round_up_pow2(N + N / 16) > W) ? round_up_pow2(N + N / 16) : W;
+    static const std::size_t MASK  = SLOTS - 1;
+    static const std::size_t NONE  = static_cast<std::size_t>(-1);
+
+public:
+    using key_type    = K;
+    using mapped_type = V;
+    using size_type   = std::size_t;
+
+    static const size_type CAPACITY     = N;
+    static const uint8_t   MAX_DISTANCE = static_cast<uint8_t>(128 - W); //!< longest probe sequence, in slots
+
+    StaticMap() : _size(0)
+    {
+        std::memset(_distance, 0, sizeof(_distance));
+        std::memset(_tag, 0, sizeof(_tag));
+    }
+
+    StaticMap(
+        const StaticMap& other
+    ) : _size(0)
+    {
+        copy(other);
+    }
+
+    ~StaticMap()
+    {
+        destroy();
+    }
+
+    StaticMap&
+    operator=(
+        const StaticMap& other
+    )
+    {
+        if (&other != this) {
+            destroy();
+            copy(other);
+        }
+
+        return *this;
+    }
+
+    /*! \brief Number of pairs
+     *
+     */
+    size_type
+    size() const
+    {
+        return _size;
+    }
+
+    constexpr size_type
+    capacity() const
+    {
+        return N;
+    }
+
+    bool
+    empty() const
+    {
+        return _size == 0;
+    }
+
+    bool
+    full() const
+    {
+        return _size == N;
+    }
+
+    /*! \brief Value of a key
+     *
+     * \return pointer to the value, nullptr if the key is not there
+     */
+    template <typename Q>
+    V*
+    find(
+        const Q& key
+    )
+    {
+        const std::size_t slot = lookup(key, hash(key));
+
+        return (slot != NONE) ? &entry(slot).value : nullptr;
+    }
+
+    template <typename Q>
+    const V*
+    find(
+        const Q& key
+    ) const
+    {
+        const std::size_t slot = lookup(key, hash(key));
+
+        return (slot != NONE) ? &entry(slot).value : nullptr;
+    }
+
+    template <typename Q>
+    bool
+    contains(
+        const Q& key
+    ) const
+    {
+        return lookup(key, hash(key)) != NONE;
+    }
+
+    /*! \brief Add a pair, or replace the value of a key that is there
+     *
+     * \return false if there is no room; the map is left as it was
+     */
+    bool
+    insert(
+        const K& key,
+        const V& value
+    )
+    {
+        const uint64_t    h    = hash(key);
+        const std::size_t slot = lookup(key, h);
+
+        if (slot != NONE) {
+            entry(slot).value = value;
+            return true;
+        }
+
+        if (_size == N) {
+            return false;
+        }
+
+        // The key goes before the first entry closer to its home than the key would be
+        std::size_t i = static_cast<std::size_t>(h) & MASK;
+        uint8_t     d = 1;
+
+        while (_distance[i] >= d) {
+            i = (i + 1) & MASK;
+            d++;
+
+            if (d > MAX_DISTANCE) {
+                return false;
+            }
+        }
+
+        // The run from there to the next empty slot moves one slot further from home; there is one, as _size < N
+        std::size_t e = i;
+
+        while (_distance[e] != 0) {
+            if (_distance[e] == MAX_DISTANCE) {
+                return false;
+            }
+
+            e = (e + 1) & MASK;
+        }
+
+        if (e == i) {
+            new (&entry(i)) Entry(key, value);
+        } else {
+            std::size_t j = (e - 1) & MASK;
+
+            new (&entry(e)) Entry(std::move(entry(j)));
+            setMeta(e, _distance[j] + 1, _tag[j]);
+
+            for (; j != i; j = (j - 1) & MASK) {
+                const std::size_t prev = (j - 1) & MASK;
+
+                entry(j) = std::move(entry(prev));
+                setMeta(j, _distance[prev] + 1, _tag[prev]);
+            }
+
+            entry(i).key   = key;
+            entry(i).value = value;
+        }
+
+        setMeta(i, d, tag(h));
+        _size++;
+
+        return true;
+    } // insert
+
+    /*! \brief Remove a key
+     *
+     * The entries that follow, in the same run, move back by one slot.
+     *
+     * \return false if the key is not there
+     */
+    template <typename Q>
+    bool
+    erase(
+        const Q& key
+    )
+    {
+        std::size_t i = lookup(key, hash(key));
+
+        if (i == NONE) {
+            return false;
+        }
+
+        for (std::size_t j = (i + 1) & MASK; _distance[j] > 1; j = (j + 1) & MASK) {
+            entry(i) = std::move(entry(j));
+            setMeta(i, _distance[j] - 1, _tag[j]);
+            i = j;
+        }
+
+        entry(i).~Entry();
+        setMeta(i, 0, 0);
+        _size--;
+
+        return true;
+    }
+
+    void
+    clear()
+    {
+        destroy();
+        std::memset(_distance, 0, sizeof(_distance));
+        std::memset(_tag, 0, sizeof(_tag));
+        _size = 0;
+    }
+
+    /*! \brief Visit all the pairs, in no particular order
+     *
+     * The map must not be modified by the visitor, but the values can.
+     *
+     * \return number of visited pairs
+     */
+    template <typename F>
+    size_type
+    forEach(
+        F visitor //!< [in] called as visitor(const K&, V&)
+    )
+    {
+        for (std::size_t i = 0; i < SLOTS; i++) {
+            if (_distance[i] != 0) {
+                visitor(static_cast<const K&>(entry(i).key), entry(i).value);
+            }
+        }
+
+        return _size;
+    }
+
+    template <typename F>
+    size_type
+    forEach(
+        F visitor //!< [in] called as visitor(const K&, const V&)
+    ) const
+    {
+        for (std::size_t i = 0; i < SLOTS; i++) {
+            if (_distance[i] != 0) {
+                visitor(entry(i).key, entry(i).value);
+            }
+        }
+
+        return _size;
+    }
+
+private:
+    struct Entry {
+        K key;
+        V value;
+
+        Entry(
+            const K& k,
+            const V& v
+        ) : key(k), value(v) {}
+    };
+
+    template <typename Q>
+    static uint64_t
+    hash(
+        const Q& key
+    )
+    {
+        return Hash::mix(TRAITS::hash(key));
+    }
+
+    static uint8_t
+    tag(
+        uint64_t h
+    )
+    {
+        // The top bits: the bottom ones pick the home slot
+        return static_cast<uint8_t>(h >> 56);
+    }
+
+    Entry&
+    entry(
+        std::size_t i
+    )
+    {
+        return reinterpret_cast<Entry*>(&_storage)[i];
+    }
+
+    const Entry&
+    entry(
+        std::size_t i
+    ) const
+    {
+        return reinterpret_cast<const Entry*>(&_storage)[i];
+    }
+
+    void
+    setMeta(
+        std::size_t i,
+        unsigned    distance,
+        uint8_t     tag
+    )
+    {
+        _distance[i] = static_cast<uint8_t>(distance);
+        _tag[i]      = tag;
+
+        if (i < W) {
+            _distance[SLOTS + i] = static_cast<uint8_t>(distance);
+            _tag[SLOTS + i]      = tag;
+        }
+    }
+
+    /*! \brief Slot of a key
+     *
+     * Slot home + j can hold the key only if its entry is at least as far from its own home,
+     * i.e. _distance[home + j] >= j + 1: the run ends at the first slot where it is not.
+     * For a word of slots starting at distance d - 1, (_distance | 0x80..) - (d, d + 1, ...) has the high bit
+     * set exactly where _distance >= d + j, as the bytes are below 128 and the subtraction never borrows across them.
+     */
+    template <typename Q>
+    std::size_t
+    lookup(
+        const Q&       key,
+        const uint64_t h
+    ) const
+    {
+        static const Word HIGH = Swar::broadcast(0x80);
+
+        const uint8_t t = tag(h);
+        std::size_t   i = static_cast<std::size_t>(h) & MASK;
+        uint8_t       d = 1;
+
+        while (d <= MAX_DISTANCE) {
+            const Word reach = ((Swar::load(_distance + i) | HIGH) - (steps() + Swar::broadcast(d))) & HIGH;
+            const Word stop  = ~reach & HIGH;
+            Word       match = Swar::equalBytes(Swar::load(_tag + i), t) & reach;
+
+            if (stop != 0) {
+                // Only the slots before the end of the run
+                match &= (stop & (~stop + 1)) - 1;
+            }
+
+            while (match != 0) {
+                const std::size_t slot = (i + Swar::firstByte(match)) & MASK;
+
+                if (TRAITS::equal(entry(slot).key, key)) {
+                    return slot;
+                }
+
+                match &= match - 1;
+            }
+
+            if (stop != 0) {
+                return NONE;
+            }
+
+            i  = (i + W) & MASK;
+            d += W;
+        }
+
+        return NONE;
+    } // lookup
+
+    static constexpr Word
+    steps(
+        std::size_t j = W - 1
+    )
+    {
+        // 0, 1, 2, ... in the bytes, from the first one
+        return (j == 0) ? 0 : ((static_cast<Word>(j) << (8 * j)) | steps(j - 1));
+    }
+
+    void
+    copy(
+        const StaticMap& other
+    )
+    {
+        for (std::size_t i = 0; i < SLOTS; i++) {
+            if (other._distance[i] != 0) {
+                new (&entry(i)) Entry(other.entry(i));
+            }
+        }
+
+        std::memcpy(_distance, other._distance, sizeof(_distance));
+        std::memcpy(_tag, other._tag, sizeof(_tag));
+        _size = other._size;
+    }
+
+    void
+    destroy()
+    {
+        if (!std::is_trivially_destructible<Entry>::value) {
+            for (std::size_t i = 0; i < SLOTS; i++) {
+                if (_distance[i] != 0) {
+                    entry(i).~Entry();
+                }
+            }
+        }
+    }
+
+    typename std::aligned_storage<sizeof(Entry) * SLOTS, alignof(Entry)>::type _storage;
+    uint8_t   _distance[SLOTS + W]; //!< distance from home + 1, 0 if empty; the first W repeated at the end
+    uint8_t   _tag[SLOTS + W]; //!< 8 bits of the hash
+    size_type _size;
+};
+
+NAMESPACE_CORE_END
@@ -0,0 +1,600 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Array.hpp>
+
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief StaticVector
+ *
+ * core::StaticVector is a vector with a fixed capacity and no heap: up to N elements,
+ * in storage that is part of the object, with the number of elements in use.
+ *
+ * Only the elements in use exist: the unused slots are not constructed, copied or destroyed.
+ * For trivially copyable T, copies, insertions and removals are memcpy and memmove.
+ *
+ * The elements are stored first, as in Array<T, N>: when the vector is full, array() gives access to them as such.
+ *
+ * \code
+ * core::StaticVector<Sample, 32> samples;
+ *
+ * while (source.ready() && samples.push_back(source.read())) {}
+ * \endcode
+ *
+ * Mutations that do not fit return false and leave the vector as it was.
+ *
+ * \tparam T type of the elements
+ * \tparam N capacity
+ */
+template <typename T, std::size_t N>
+class StaticVector
+{
+    static_assert(N >= 1, "N must be at least 1");
+
+public:
+    using value_type      = T; //!< Type of stored objects
+    using pointer         = value_type *; //!< Pointer
+    using const_pointer   = const value_type *; //!< Const Pointer
+    using reference       = value_type &; //!< Reference
+    using const_reference = const value_type &; //!< Const Reference
+    using iterator        = value_type *; //!< Iterator
+    using const_iterator  = const value_type *; //!< Const Iterator
+    using size_type       = std::size_t; //!< Type of index and size
+    using difference_type = std::ptrdiff_t;
+
+    static const size_type CAPACITY = N;
+
+    StaticVector() : _size(0) {}
+
+    StaticVector(
+        const StaticVector& other
+    ) : _size(0)
+    {
+        append(other.data(), other.size());
+    }
+
+    StaticVector(
+        StaticVector&& other
+    ) : _size(0)
+    {
+        for (size_type i = 0; i < other._size; i++) {
+            new (data() + i) T(std::move(other[i]));
+        }
+
+        _size = other._size;
+    }
+
+    /*! \brief Vector with the elements of a list
+     *
+     * \pre list.size() <= N
+     */
+    StaticVector(
+        std::initializer_list<T> list
+    ) : _size(0)
+    {
+        CORE_ASSERT(list.size() <= N);
+
+        append(list.begin(), list.size());
+    }
+
+    ~StaticVector()
+    {
+        clear();
+    }
+
+    StaticVector&
+    operator=(
+        const StaticVector& other
+    )
+    {
+        if (&other != this) {
+            clear();
+            append(other.data(), other.size());
+        }
+
+        return *this;
+    }
+
+    StaticVector&
+    operator=(
+        StaticVector&& other
+    )
+    {
+        if (&other != this) {
+            clear();
+
+            for (size_type i = 0; i < other._size; i++) {
+                new (data() + i) T(std::move(other[i]));
+            }
+
+            _size = other._size;
+        }
+
+        return *this;
+    }
+
+    // Iterators.
+    iterator
+    begin()
+    {
+        return data();
+    }
+
+    const_iterator
+    begin() const
+    {
+        return data();
+    }
+
+    iterator
+    end()
+    {
+        return data() + _size;
+    }
+
+    const_iterator
+    end() const
+    {
+        return data() + _size;
+    }
+
+    const_iterator
+    cbegin() const
+    {
+        return data();
+    }
+
+    const_iterator
+    cend() const
+    {
+        return data() + _size;
+    }
+
+    // Capacity.
+    /*! \brief Number of elements
+     *
+     */
+    size_type
+    size() const
+    {
+        return _size;
+    }
+
+    constexpr size_type
+    capacity() const
+    {
+        return N;
+    }
+
+    constexpr size_type
+    max_size() const
+    {
+        return N;
+    }
+
+    bool
+    empty() const
+    {
+        return _size == 0;
+    }
+
+    bool
+    full() const
+    {
+        return _size == N;
+    }
+
+    // Element access.
+    reference
+    operator[](
+        size_type n //!< [in] index
+    )
+    {
+        return data()[n];
+    }
+
+    const_reference
+    operator[](
+        size_type n //!< [in] index
+    ) const
+    {
+        return data()[n];
+    }
+
+    /*! \brief Element access (with range check)
+     *
+     * \pre \c n must index an element in use
+     */
+    reference
+    at(
+        size_type n //!< [in] index
+    )
+    {
+        CORE_ASSERT(n < _size);
+
+        return data()[n];
+    }
+
+    const_reference
+    at(
+        size_type n //!< [in] index
+    ) const
+    {
+        CORE_ASSERT(n < _size);
+
+        return data()[n];
+    }
+
+    reference
+    front()
+    {
+        return data()[0];
+    }
+
+    const_reference
+    front() const
+    {
+        return data()[0];
+    }
+
+    reference
+    back()
+    {
+        return data()[_size - 1];
+    }
+
+    const_reference
+    back() const
+    {
+        return data()[_size - 1];
+    }
+
+    pointer
+    data()
+    {
+        return reinterpret_cast<pointer>(&_storage);
+    }
+
+    const_pointer
+    data() const
+    {
+        return reinterpret_cast<const_pointer>(&_storage);
+    }
+
+    /*! \brief The elements, as an Array
+     *
+     * \pre full()
+     */
+    Array<T, N>&
+    array()
+    {
+        CORE_ASSERT(full());
+
+        return *reinterpret_cast<Array<T, N>*>(&_storage);
+    }
+
+    const Array<T, N>&
+    array() const
+    {
+        CORE_ASSERT(full());
+
+        return *reinterpret_cast<const Array<T, N>*>(&_storage);
+    }
+
+    // Modifiers.
+    bool
+    push_back(
+        const T& value
+    )
+    {
+        return emplace_back(value);
+    }
+
+    bool
+    push_back(
+        T&& value
+    )
+    {
+        return emplace_back(std::move(value));
+    }
+
+    /*! \brief Construct an element at the end
+     *
+     * \return false if the vector is full
+     */
+    template <typename ... ARGS>
+    bool
+    emplace_back(
+        ARGS&& ... args
+    )
+    {
+        if (_size == N) {
+            return false;
+        }
+
+        new (data() + _size) T(std::forward<ARGS>(args) ...);
+        _size++;
+
+        return true;
+    }
+
+    /*! \brief Remove the last element
+     *
+     * \pre !empty()
+     */
+    void
+    pop_back()
+    {
+        CORE_ASSERT(_size > 0);
+
+        _size--;
+        data()[_size].~T();
+    }
+
+    /*! \brief Append \c n elements
+     *
+     * \return false if they do not fit; nothing is appended then
+     */
+    bool
+    append(
+        const T*  values,
+        size_type n
+    )
+    {
+        if (n > N - _size) {
+            return false;
+        }
+
+        construct(data() + _size, values, n, std::is_trivially_copyable<T>());
+        _size += n;
+
+        return true;
+    }
+
+    /*! \brief Replace the elements with \c n elements
+     *
+     * \return false if they do not fit; nothing is changed then
+     */
+    bool
+    assign(
+        const T*  values,
+        size_type n
+    )
+    {
+        if (n > N) {
+            return false;
+        }
+
+        clear();
+
+        return append(values, n);
+    }
+
+    /*! \brief Insert an element before index \c pos
+     *
+     * \pre pos <= size()
+     * \return false if the vector is full
+     */
+    bool
+    insert(
+        size_type pos,
+        const T&  value
+    )
+    {
+        CORE_ASSERT(pos <= _size);
+
+        if (_size == N) {
+            return false;
+        }
+
+        if (pos == _size) {
+            new (data() + pos) T(value);
+            _size++;
+
+            return true;
+        }
+
+        // Copy first: value may be one of the elements
+        T copy(value);
+
+        openGap(pos, std::is_trivially_copyable<T>());
+        data()[pos] = std::move(copy);
+        _size++;
+
+        return true;
+    }
+
+    /*! \brief Remove the elements in [first, last)
+     *
+     * \pre first <= last <= size()
+     */
+    void
+    erase(
+        size_type first,
+        size_type last
+    )
+    {
+        CORE_ASSERT((first <= last) && (last <= _size));
+
+        const size_type n = last - first;
+
+        if (n == 0) {
+            return;
+        }
+
+        closeGap(first, n, std::is_trivially_copyable<T>());
+        _size -= n;
+    }
+
+    /*! \brief Remove the element at index \c pos
+     *
+     * \pre pos < size()
+     */
+    void
+    erase(
+        size_type pos
+    )
+    {
+        erase(pos, pos + 1);
+    }
+
+    /*! \brief Change the number of elements
+     *
+     * New elements are value-initialized (zero for arithmetic types).
+     *
+     * \return false if n > N
+     */
+    bool
+    resize(
+        size_type n
+    )
+    {
+        if (n > N) {
+            return false;
+        }
+
+        while (_size > n) {
+            pop_back();
+        }
+
+        while (_size < n) {
+            new (data() + _size) T();
+            _size++;
+        }
+
+        return true;
+    }
+
+    void
+    clear()
+    {
+        destroy(std::is_trivially_destructible<T>());
+        _size = 0;
+    }
+
+private:
+    static void
+    construct(
+        T*        to,
+        const T*  from,
+        size_type n,
+        std::true_type // trivially copyable
+    )
+    {
+        ArrayOps::copy(to, from, n);
+    }
+
+    static void
+    construct(
+        T*        to,
+        const T*  from,
+        size_type n,
+        std::false_type
+    )
+    {
+        for (size_type i = 0; i < n; i++) {
+            new (to + i) T(from[i]);
+        }
+    }
+
+    void
+    destroy(
+        std::true_type // trivially destructible
+    ) {}
+
+    void
+    destroy(
+        std::false_type
+    )
+    {
+        for (size_type i = 0; i < _size; i++) {
+            data()[i].~T();
+        }
+    }
+
+    // Make room at pos < _size, leaving there an element (or raw bytes) to be assigned
+    void
+    openGap(
+        size_type pos,
+        std::true_type // trivially copyable
+    )
+    {
+        std::memmove(data() + pos + 1, data() + pos, (_size - pos) * sizeof(T));
+    }
+
+    void
+    openGap(
+        size_type pos,
+        std::false_type
+    )
+    {
+        new (data() + _size) T(std::move(data()[_size - 1]));
+
+        for (size_type i = _size - 1; i > pos; i--) {
+            data()[i] = std::move(data()[i - 1]);
+        }
+    }
+
+    void
+    closeGap(
+        size_type first,
+        size_type n,
+        std::true_type // trivially copyable
+    )
+    {
+        std::memmove(data() + first, data() + first + n, (_size - first - n) * sizeof(T));
+    }
+
+    void
+    closeGap(
+        size_type first,
+        size_type n,
+        std::false_type
+    )
+    {
+        for (size_type i = first; i + n < _size; i++) {
+            data()[i] = std::move(data()[i + n]);
+        }
+
+        for (size_type i = _size - n; i < _size; i++) {
+            data()[i].~T();
+        }
+    }
+
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _storage;
+    size_type _size;
+};
+
+template <typename T, std::size_t N>
+inline bool
+operator==(
+    const StaticVector<T, N>& lhs,
+    const StaticVector<T, N>& rhs
+)
+{
+    return (lhs.size() == rhs.size()) && ArrayOps::equal(lhs.data(), rhs.data(), lhs.size());
+}
+
+template <typename T, std::size_t N>
+inline bool
+operator!=(
+    const StaticVector<T, N>& lhs,
+    const StaticVector<T, N>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+NAMESPACE_CORE_END
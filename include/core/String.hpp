@@ -9,6 +9,7 @@
 #include <core/namespace.hpp>
 #include <core/common.hpp>
 #include <core/Array.hpp>
+#include <core/Swar.hpp>
 
 NAMESPACE_CORE_BEGIN
 
@@ -87,16 +88,14 @@ struct String {
         }
     }
 
+    /*! \brief Length of the string
+     *
+     * Scans for the \0 one word at a time. Use SizedString when the length is needed often.
+     */
     std::size_t
     length() const
     {
-        for (std::size_t i = 0; i < S; i++) {
-            if (_data[i] == 0) {
-                return i;
-            }
-        }
-
-        return S;
+        return Swar::length(data(), S);
     }
 
     void
@@ -9,6 +9,10 @@
 #include <core/namespace.hpp>
 #include <core/common.hpp>
 #include <core/String.hpp>
+#include <core/SizedString.hpp>
+#include <core/NumberFormat.hpp>
+#include <core/Format.hpp>
+#include <core/Codec.hpp>
 
 #include <cstdarg>
 #include <cstdio>
@@ -26,22 +30,22 @@ NAMESPACE_CORE_BEGIN
  */
 using FormatterFunction = int(char* buffer, std::size_t length, const void* data);
 
-/*! \brief StringBuffer
- *
- * core::StringBuffer makes it easy to build up a string
- *
- * \warning This implementation is rather incomplete, and work in progress
+/*! \brief StringWriter
  *
- * \tparam S size of the buffer
+ * core::StringWriter builds up a string into storage it does not own.
+ * It implements the append API of StringBuffer, for buffers whose size is only known at run time
+ * (e.g. sized with StringMeasure and allocated from an arena).
  */
-template <std::size_t SIZE>
-class StringBuffer:
-    public core::String<SIZE>
+class StringWriter
 {
-	static_assert(SIZE >= 1, "SIZE must be at least 1 (= the trailing 0)");
 public:
-    StringBuffer()
+    StringWriter(
+        char*       buffer, //!< [in] storage
+        std::size_t size //!< [in] size of the storage, the trailing \0 included
+    ) : _begin(buffer), _curr(buffer), _top(buffer + size - 1), _mark(buffer)
     {
+        CORE_ASSERT(size >= 1);
+
         reset();
     }
 
@@ -54,7 +58,8 @@ public:
     		return false;
     	}
 
-        return appendString(s, strlen(s));
+        // No strlen, the bounded scan below stops at the terminator anyway
+        return appendString(s, static_cast<size_t>(-1));
     }
 
     inline bool
@@ -73,21 +78,44 @@ public:
             m = (size_t)(_top - _curr);
         }
 
-        while (m > 0) {
-            if (*s == 0) {
-                *_curr = 0;
-                return true;
-            }
+        // One pass to find the terminator within the limit (memchr stops at the first match,
+        // and it is word-at-a-time / SIMD in any decent libc), then a bulk copy
+        const void* end = memchr(s, 0, m);
 
-            *_curr++ = *s++;
-            m--;
+        if (end != nullptr) {
+            m = static_cast<const char*>(end) - s;
         }
 
+        memcpy(_curr, s, m);
+        _curr += m;
         *_curr = 0;
 
         return true;
     } // append
 
+    /*! \brief Append a SizedString
+     *
+     * Its length is known, so there is nothing to scan.
+     */
+    template <std::size_t S>
+    inline bool
+    appendString(
+        const SizedString<S>& s
+    )
+    {
+        std::size_t m = s.length();
+
+        if (m > (size_t)(_top - _curr)) {
+            m = (size_t)(_top - _curr);
+        }
+
+        memcpy(_curr, s.data(), m);
+        _curr += m;
+        *_curr = 0;
+
+        return true;
+    }
+
     inline bool
     appendChar(
         const char c
@@ -111,11 +139,12 @@ public:
     {
         va_list ap;
 
+        // The \0 written by vsnprintf can take the slot reserved for the trailing one
         va_start(ap, format);
-        auto n = vsnprintf(_curr, (_top - _curr), format, ap);
+        auto n = vsnprintf(_curr, (_top - _curr + 1), format, ap);
         va_end(ap);
 
-        if ((n >= 0) && (n < (_top - _curr))) {
+        if ((n >= 0) && (n < (_top - _curr + 1))) {
             _curr += n;
             *_curr = 0;
             return true;
@@ -124,6 +153,151 @@ public:
         return false;
     }
 
+    /*! \brief Append a signed integer
+     *
+     * Same output as appendFormat("%lld", value), without going through vsnprintf.
+     */
+    bool
+    appendInt(
+        int64_t value
+    )
+    {
+        return advance(NumberFormat::formatInt(_curr, (_top - _curr + 1), value));
+    }
+
+    /*! \brief Append an unsigned integer
+     *
+     * Same output as appendFormat("%llu", value), without going through vsnprintf.
+     */
+    bool
+    appendUInt(
+        uint64_t value
+    )
+    {
+        return advance(NumberFormat::formatUInt(_curr, (_top - _curr + 1), value));
+    }
+
+    /*! \brief Append an hexadecimal integer
+     *
+     * Same output as appendFormat("%0*llx", width, value), without going through vsnprintf.
+     */
+    bool
+    appendHex(
+        uint64_t value,
+        unsigned width = 0,
+        bool     upper = false
+    )
+    {
+        return advance(NumberFormat::formatHex(_curr, (_top - _curr + 1), value, width, upper));
+    }
+
+    /*! \brief Append a floating point value in fixed point notation
+     *
+     * Same output as appendFormat("%.*f", precision, value), without going through vsnprintf.
+     */
+    bool
+    appendFixed(
+        double   value,
+        unsigned precision = 6
+    )
+    {
+        return advance(NumberFormat::formatFixed(_curr, (_top - _curr + 1), value, precision));
+    }
+
+    /*! \brief Append a float, with the shortest text that reads back as the same value
+     *
+     * See NumberFormat::formatShortest.
+     */
+    bool
+    appendFloat(
+        float value
+    )
+    {
+        return advance(NumberFormat::formatShortest(_curr, (_top - _curr + 1), value));
+    }
+
+    // A double would be silently narrowed: use appendDouble, or appendFixed
+    bool
+    appendFloat(
+        double value
+    ) = delete;
+
+    /*! \brief Append a double, with the shortest text that reads back as the same value
+     *
+     * See NumberFormat::formatShortest.
+     */
+    bool
+    appendDouble(
+        double value
+    )
+    {
+        return advance(NumberFormat::formatShortest(_curr, (_top - _curr + 1), value));
+    }
+
+    /*! \brief Append binary data as hexadecimal text
+     *
+     * Same output as calling appendFormat("%02x", byte) for each byte, but much faster.
+     */
+    bool
+    appendHexData(
+        const void* data,
+        std::size_t n,
+        bool        upper = false
+    )
+    {
+        return advance(Hex::encode(_curr, (_top - _curr + 1), data, n, upper));
+    }
+
+    template <std::size_t S>
+    bool
+    appendHexData(
+        const Array<uint8_t, S>& data,
+        bool                     upper = false
+    )
+    {
+        return appendHexData(data.data(), S, upper);
+    }
+
+    /*! \brief Append binary data as base64 text
+     *
+     */
+    bool
+    appendBase64(
+        const void* data,
+        std::size_t n
+    )
+    {
+        return advance(Base64::encode(_curr, (_top - _curr + 1), data, n));
+    }
+
+    template <std::size_t S>
+    bool
+    appendBase64(
+        const Array<uint8_t, S>& data
+    )
+    {
+        return appendBase64(data.data(), S);
+    }
+
+    /*! \brief Append a compile time parsed format
+     *
+     * Same output as appendFormat(format, args...), but the format string is parsed by the compiler
+     * and the arguments are type checked against it (see core::Format).
+     *
+     * \code
+     * buffer.appendFmt(CORE_FORMAT("%s = %d"), name, value);
+     * \endcode
+     */
+    template <typename F, typename ... ARGS>
+    bool
+    appendFmt(
+        F           format,
+        const ARGS& ... args
+    )
+    {
+        return advance(Format::format(format, _curr, (_top - _curr + 1), args ...));
+    }
+
     bool
     appendFrmttr(
         FormatterFunction* function,
@@ -139,15 +313,7 @@ public:
         const void*        data
     )
     {
-        auto n = function(_curr, (_top - _curr), data);
-
-        if ((n >= 0) && (n < (_top - _curr))) {
-            _curr += n;
-            *_curr = 0;
-            return true;
-        }
-
-        return false;
+        return advance(function(_curr, (_top - _curr + 1), data));
     }
 
     void
@@ -166,16 +332,21 @@ public:
     void
     reset()
     {
-        _curr  = this->data();
+        _curr  = _begin;
         _mark  = _curr;
-        _top   = _curr + SIZE - 1;
         *_curr = 0;
     }
 
     std::size_t
     length() const
     {
-        return _curr - this->data();
+        return _curr - _begin;
+    }
+
+    const char*
+    c_str() const
+    {
+        return _begin;
     }
 
     std::size_t
@@ -184,9 +355,47 @@ public:
         return _top - _curr;
     }
 private:
-    typename core::String<SIZE>::pointer _curr = nullptr;
-    typename core::String<SIZE>::pointer _top  = nullptr;
-    typename core::String<SIZE>::pointer _mark = nullptr;
+    inline bool
+    advance(
+        int n
+    )
+    {
+        if ((n >= 0) && (n < (_top - _curr + 1))) {
+            _curr += n;
+            *_curr = 0;
+            return true;
+        }
+
+        // The formatter may have written a partial field: the buffer must stay terminated at _curr
+        *_curr = 0;
+        return false;
+    }
+
+    char* _begin;
+    char* _curr;
+    char* _top;
+    char* _mark;
+};
+
+/*! \brief StringBuffer
+ *
+ * core::StringBuffer makes it easy to build up a string
+ *
+ * \warning This implementation is rather incomplete, and work in progress
+ *
+ * \tparam S size of the buffer
+ */
+template <std::size_t SIZE>
+class StringBuffer:
+    public core::String<SIZE>,
+    public StringWriter
+{
+	static_assert(SIZE >= 1, "SIZE must be at least 1 (= the trailing 0)");
+public:
+    StringBuffer() : StringWriter(core::String<SIZE>::data(), SIZE) {}
+
+    using StringWriter::length;
+    using StringWriter::c_str;
 };
 
 NAMESPACE_CORE_END
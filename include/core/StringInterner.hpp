@@ -0,0 +1,274 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+
+#include <atomic>
+#include <type_traits>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief StringInterner
+ *
+ * core::StringInterner maps strings to dense ids, 0, 1, 2, ... in order of insertion,
+ * so that names can be compared by comparing their ids. Each name is stored once, \0 terminated.
+ *
+ * \code
+ * static core::StringInterner<64, 1024> names;
+ *
+ * uint32_t id = names.intern(topic.name);   // once
+ * ...
+ * if (id == other) { ... }                  // then, on the hot path
+ * \endcode
+ *
+ * The index is an open addressing table, kept at most half full, whose slots hold the ids.
+ * Entries are never removed, so:
+ * - lookups take no lock: they end at the first empty slot, and are wait-free;
+ * - intern() takes the SysLock only to add a name that is not there yet:
+ *   it writes the entry first, then publishes its slot with a release store.
+ *
+ * \tparam CAPACITY maximum number of names
+ * \tparam STORAGE size of the character storage, the \0 of every name included
+ */
+template <std::size_t CAPACITY, std::size_t STORAGE>
+class StringInterner:
+    private core::Uncopyable
+{
+    static_assert(CAPACITY >= 1, "CAPACITY must be at least 1");
+    static_assert(CAPACITY < 0xFFFFFFFFu, "Ids are 32 bit");
+
+    static const std::size_t SLOTS = 2 * round_up_pow2(CAPACITY);
+
+public:
+    static const uint32_t INVALID = 0xFFFFFFFFu; //!< id of a name that is not there, or does not fit
+
+    StringInterner() : _size(0), _used(0)
+    {
+        for (std::size_t i = 0; i < SLOTS; i++) {
+            _slot[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /*! \brief Number of names
+     *
+     */
+    std::size_t
+    size() const
+    {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    constexpr std::size_t
+    capacity() const
+    {
+        return CAPACITY;
+    }
+
+    /*! \brief Id of a name of known length
+     *
+     * Wait-free.
+     *
+     * \return the id, INVALID if the name has not been interned
+     */
+    uint32_t
+    find(
+        const char* name, //!< [in] name
+        std::size_t length //!< [in] its length
+    ) const
+    {
+        return find(name, length, Hash::string(name, length));
+    }
+
+    uint32_t
+    find(
+        const char* name
+    ) const
+    {
+        if (name == nullptr) {
+            return INVALID;
+        }
+
+        return find(name, std::strlen(name));
+    }
+
+    /*! \brief Id of a name held in a String, ConstString, SizedString or StringLiteral
+     *
+     */
+    template <typename STRING>
+    typename std::enable_if<std::is_class<STRING>::value, uint32_t>::type
+    find(
+        const STRING& name
+    ) const
+    {
+        return find(name.data(), name.length());
+    }
+
+    /*! \brief Id of a name of known length, adding it if needed
+     *
+     * \return the id, INVALID if the name is not there and there is no room for it
+     */
+    uint32_t
+    intern(
+        const char* name, //!< [in] name
+        std::size_t length //!< [in] its length
+    )
+    {
+        const uint64_t hash = Hash::string(name, length);
+        uint32_t       id   = find(name, length, hash);
+
+        if (id != INVALID) {
+            return id;
+        }
+
+        core::os::SysLock::acquire();
+
+        // Someone else may have added it meanwhile
+        id = find(name, length, hash);
+
+        if (id == INVALID) {
+            id = insert(name, length, hash);
+        }
+
+        core::os::SysLock::release();
+
+        return id;
+    }
+
+    uint32_t
+    intern(
+        const char* name
+    )
+    {
+        if (name == nullptr) {
+            return INVALID;
+        }
+
+        return intern(name, std::strlen(name));
+    }
+
+    template <typename STRING>
+    typename std::enable_if<std::is_class<STRING>::value, uint32_t>::type
+    intern(
+        const STRING& name
+    )
+    {
+        return intern(name.data(), name.length());
+    }
+
+    /*! \brief Name of an id
+     *
+     * \pre id < size()
+     * \return the \0 terminated name
+     */
+    const char*
+    name(
+        uint32_t id
+    ) const
+    {
+        CORE_ASSERT(id < size());
+
+        return _storage + _entry[id].offset;
+    }
+
+    /*! \brief Length of the name of an id
+     *
+     * \pre id < size()
+     */
+    std::size_t
+    length(
+        uint32_t id
+    ) const
+    {
+        CORE_ASSERT(id < size());
+
+        return _entry[id].length;
+    }
+
+private:
+    struct Entry {
+        uint64_t    hash;
+        std::size_t offset;
+        std::size_t length;
+    };
+
+    uint32_t
+    find(
+        const char* name,
+        std::size_t length,
+        uint64_t    hash
+    ) const
+    {
+        std::size_t i = static_cast<std::size_t>(Hash::mix(hash));
+
+        // The table is at most half full, so there is always an empty slot to stop at
+        for (;; i++) {
+            // Slots hold id + 1, so that zero means empty
+            const uint32_t s = _slot[i & (SLOTS - 1)].load(std::memory_order_acquire);
+
+            if (s == 0) {
+                return INVALID;
+            }
+
+            const Entry& e = _entry[s - 1];
+
+            if ((e.hash == hash) && (e.length == length) && (std::memcmp(_storage + e.offset, name, length) == 0)) {
+                return s - 1;
+            }
+        }
+    }
+
+    /*! \brief Add a name
+     *
+     * \pre the SysLock is held, and the name is not there
+     */
+    uint32_t
+    insert(
+        const char* name,
+        std::size_t length,
+        uint64_t    hash
+    )
+    {
+        const std::size_t id = _size.load(std::memory_order_relaxed);
+
+        if ((id == CAPACITY) || (_used + length + 1 > STORAGE)) {
+            return INVALID;
+        }
+
+        Entry& e = _entry[id];
+
+        e.hash   = hash;
+        e.offset = _used;
+        e.length = length;
+
+        std::memcpy(_storage + _used, name, length);
+        _storage[_used + length] = 0;
+        _used += length + 1;
+
+        std::size_t i = static_cast<std::size_t>(Hash::mix(hash));
+
+        while (_slot[i & (SLOTS - 1)].load(std::memory_order_relaxed) != 0) {
+            i++;
+        }
+
+        // Publish: lookups that see the slot also see the entry
+        _slot[i & (SLOTS - 1)].store(static_cast<uint32_t>(id + 1), std::memory_order_release);
+        _size.store(id + 1, std::memory_order_release);
+
+        return static_cast<uint32_t>(id);
+    } // insert
+
+    std::atomic<uint32_t>    _slot[SLOTS];
+    Entry _entry[CAPACITY];
+    char _storage[STORAGE];
+    std::atomic<std::size_t> _size;
+    std::size_t _used;
+};
+
+NAMESPACE_CORE_END
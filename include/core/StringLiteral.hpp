@@ -0,0 +1,311 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+#include <core/String.hpp>
+#include <core/ConstString.hpp>
+#include <core/SizedString.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief StringLiteral
+ *
+ * core::StringLiteral is a constant string whose length and hash are computed by the compiler:
+ *
+ * \code
+ * static constexpr core::StringLiteral LED_TOPIC("led");
+ *
+ * static_assert(LED_TOPIC.length() == 3, "");
+ *
+ * if (LED_TOPIC == name) { ... }
+ * \endcode
+ *
+ * Two StringLiteral compare their lengths and hashes first, and their characters only when both match.
+ * Against the other string types, the known length spares the scan for the terminator.
+ */
+class StringLiteral
+{
+public:
+    constexpr
+    StringLiteral() : _data(""), _length(0), _hash(Hash::string("", 0)) {}
+
+    template <std::size_t N>
+    constexpr
+    StringLiteral(
+        const char (&s)[N]
+    ) : _data(s), _length(length(s, N)), _hash(Hash::string(s, length(s, N))) {}
+
+    constexpr
+    StringLiteral(
+        const char* s, //!< [in] string
+        std::size_t n //!< [in] its length
+    ) : _data(s), _length(n), _hash(Hash::string(s, n)) {}
+
+    constexpr const char*
+    data() const
+    {
+        return _data;
+    }
+
+    constexpr const char*
+    c_str() const
+    {
+        return _data;
+    }
+
+    constexpr std::size_t
+    length() const
+    {
+        return _length;
+    }
+
+    constexpr uint64_t
+    hash() const
+    {
+        return _hash;
+    }
+
+    constexpr
+    operator const char*() const {
+        return _data;
+    }
+
+    /*! \brief Compare with a string of known length
+     *
+     */
+    bool
+    equals(
+        const char* s,
+        std::size_t n
+    ) const
+    {
+        return (n == _length) && (std::memcmp(s, _data, n) == 0);
+    }
+
+    /*! \brief Compare with a string of at most \c S characters, \0 terminated if shorter
+     *
+     */
+    template <std::size_t S>
+    bool
+    equalsBounded(
+        const char* s
+    ) const
+    {
+        // strncmp stops at the terminator of s, which may be shorter than _length
+        return (_length <= S) && (std::strncmp(s, _data, _length) == 0) && ((_length == S) || (s[_length] == 0));
+    }
+
+private:
+    static constexpr std::size_t
+    length(
+        const char* s,
+        std::size_t n
+    )
+    {
+        std::size_t i = 0;
+
+        while ((i < n) && (s[i] != 0)) {
+            i++;
+        }
+
+        return i;
+    }
+
+    const char* _data;
+    std::size_t _length;
+    uint64_t    _hash;
+};
+
+constexpr bool
+operator==(
+    const StringLiteral& lhs,
+    const StringLiteral& rhs
+)
+{
+    if ((lhs.length() != rhs.length()) || (lhs.hash() != rhs.hash())) {
+        return false;
+    }
+
+    // Almost surely equal, confirm
+    for (std::size_t i = 0; i < lhs.length(); i++) {
+        if (lhs.data()[i] != rhs.data()[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+constexpr bool
+operator!=(
+    const StringLiteral& lhs,
+    const StringLiteral& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const StringLiteral& lhs,
+    const String<S>&     rhs
+)
+{
+    return lhs.equalsBounded<S>(rhs.data());
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const String<S>&     lhs,
+    const StringLiteral& rhs
+)
+{
+    return rhs.equalsBounded<S>(lhs.data());
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const StringLiteral& lhs,
+    const String<S>&     rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const String<S>&     lhs,
+    const StringLiteral& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const StringLiteral&  lhs,
+    const ConstString<S>& rhs
+)
+{
+    return lhs.equalsBounded<S>(rhs.data());
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const ConstString<S>& lhs,
+    const StringLiteral&  rhs
+)
+{
+    return rhs.equalsBounded<S>(lhs.data());
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const StringLiteral&  lhs,
+    const ConstString<S>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const ConstString<S>& lhs,
+    const StringLiteral&  rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const StringLiteral&  lhs,
+    const SizedString<S>& rhs
+)
+{
+    return lhs.equals(rhs.data(), rhs.length());
+}
+
+template <std::size_t S>
+inline bool
+operator==(
+    const SizedString<S>& lhs,
+    const StringLiteral&  rhs
+)
+{
+    return rhs.equals(lhs.data(), lhs.length());
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const StringLiteral&  lhs,
+    const SizedString<S>& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+template <std::size_t S>
+inline bool
+operator!=(
+    const SizedString<S>& lhs,
+    const StringLiteral&  rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator==(
+    const StringLiteral& lhs,
+    const char*          rhs
+)
+{
+    return (std::strncmp(rhs, lhs.data(), lhs.length()) == 0) && (rhs[lhs.length()] == 0);
+}
+
+inline bool
+operator==(
+    const char*          lhs,
+    const StringLiteral& rhs
+)
+{
+    return rhs == lhs;
+}
+
+inline bool
+operator!=(
+    const StringLiteral& lhs,
+    const char*          rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator!=(
+    const char*          lhs,
+    const StringLiteral& rhs
+)
+{
+    return !(lhs == rhs);
+}
+
+NAMESPACE_CORE_END
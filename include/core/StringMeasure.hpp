@@ -0,0 +1,323 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/NumberFormat.hpp>
+#include <core/Format.hpp>
+#include <core/Codec.hpp>
+#include <core/StringBuffer.hpp>
+
+#include <cstdarg>
+#include <cstdio>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief StringMeasure
+ *
+ * core::StringMeasure has the same append API of StringBuffer, but it writes nothing: it only counts the bytes.
+ * It is the first pass of a measure-then-write formatting:
+ *
+ * \code
+ * template <typename SINK>
+ * void
+ * describe(SINK& sink) {
+ *     sink.appendString(name);
+ *     sink.appendFmt(CORE_FORMAT(" %d"), value);
+ * }
+ *
+ * core::StringMeasure measure;
+ * describe(measure);
+ *
+ * core::StringWriter writer(arena.alloc(measure.size()), measure.size());
+ * describe(writer); // never truncated
+ * \endcode
+ *
+ * Formatters and compile time formats are measured by formatting them into a stack buffer of ITEM_SIZE bytes:
+ * larger items make the append fail.
+ */
+class StringMeasure
+{
+public:
+    static const std::size_t ITEM_SIZE = 256;
+
+    StringMeasure() : _length(0), _mark(0) {}
+
+    inline bool
+    appendString(
+        const char* s
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        _length += strlen(s);
+
+        return true;
+    }
+
+    inline bool
+    appendString(
+        const char* s,
+        size_t      n
+    )
+    {
+        if (s == nullptr) {
+            return false;
+        }
+
+        const void* end = memchr(s, 0, n);
+
+        _length += (end != nullptr) ? static_cast<std::size_t>(static_cast<const char*>(end) - s) : n;
+
+        return true;
+    }
+
+    inline bool
+    appendChar(
+        const char
+    )
+    {
+        _length++;
+
+        return true;
+    }
+
+    bool
+    appendFormat(
+        const char* format,
+        ...
+    )
+    {
+        va_list ap;
+
+        va_start(ap, format);
+        auto n = vsnprintf(nullptr, 0, format, ap);
+        va_end(ap);
+
+        return add(n);
+    }
+
+    bool
+    appendInt(
+        int64_t value
+    )
+    {
+        uint64_t u = (value < 0) ? ~static_cast<uint64_t>(value) + 1 : static_cast<uint64_t>(value);
+
+        _length += NumberFormat::countDigits(u) + ((value < 0) ? 1 : 0);
+
+        return true;
+    }
+
+    bool
+    appendUInt(
+        uint64_t value
+    )
+    {
+        _length += NumberFormat::countDigits(value);
+
+        return true;
+    }
+
+    bool
+    appendHex(
+        uint64_t value,
+        unsigned width = 0,
+        bool     upper = false
+    )
+    {
+        (void)upper;
+
+        std::size_t n = 1;
+
+        for (value >>= 4; value != 0; value >>= 4) {
+            n++;
+        }
+
+        _length += (n < width) ? width : n;
+
+        return true;
+    }
+
+    bool
+    appendFixed(
+        double   value,
+        unsigned precision = 6
+    )
+    {
+        // appendFixed has the same output of printf
+        return add(snprintf(nullptr, 0, "%.*f", static_cast<int>(precision), value));
+    }
+
+    bool
+    appendFloat(
+        float value
+    )
+    {
+        char item[16];
+
+        return add(NumberFormat::formatShortest(item, sizeof(item), value));
+    }
+
+    bool
+    appendFloat(
+        double value
+    ) = delete;
+
+    bool
+    appendDouble(
+        double value
+    )
+    {
+        char item[32];
+
+        return add(NumberFormat::formatShortest(item, sizeof(item), value));
+    }
+
+    bool
+    appendHexData(
+        const void*,
+        std::size_t n,
+        bool        upper = false
+    )
+    {
+        (void)upper;
+
+        _length += 2 * n;
+
+        return true;
+    }
+
+    template <std::size_t S>
+    bool
+    appendHexData(
+        const Array<uint8_t, S>&,
+        bool upper = false
+    )
+    {
+        (void)upper;
+
+        _length += 2 * S;
+
+        return true;
+    }
+
+    bool
+    appendBase64(
+        const void*,
+        std::size_t n
+    )
+    {
+        _length += Base64::encodedLength(n);
+
+        return true;
+    }
+
+    template <std::size_t S>
+    bool
+    appendBase64(
+        const Array<uint8_t, S>&
+    )
+    {
+        _length += Base64::encodedLength(S);
+
+        return true;
+    }
+
+    template <typename F, typename ... ARGS>
+    bool
+    appendFmt(
+        F           format,
+        const ARGS& ... args
+    )
+    {
+        char item[ITEM_SIZE];
+
+        return add(Format::format(format, item, sizeof(item), args ...));
+    }
+
+    bool
+    appendFrmttr(
+        FormatterFunction* function,
+        const void*        data
+    )
+    {
+        return appendFormatter(function, data);
+    }
+
+    bool
+    appendFormatter(
+        FormatterFunction* function,
+        const void*        data
+    )
+    {
+        char item[ITEM_SIZE];
+        auto n = function(item, sizeof(item), data);
+
+        return ((n >= 0) && (static_cast<std::size_t>(n) < sizeof(item))) ? add(n) : false;
+    }
+
+    void
+    mark()
+    {
+        _mark = _length;
+    }
+
+    void
+    rewind()
+    {
+        _length = _mark;
+    }
+
+    void
+    reset()
+    {
+        _length = 0;
+        _mark   = 0;
+    }
+
+    /*! \brief Length of the string
+     *
+     */
+    std::size_t
+    length() const
+    {
+        return _length;
+    }
+
+    /*! \brief Size of the storage needed to hold the string, the trailing \0 included
+     *
+     */
+    std::size_t
+    size() const
+    {
+        return _length + 1;
+    }
+
+private:
+    bool
+    add(
+        int n
+    )
+    {
+        if (n < 0) {
+            return false;
+        }
+
+        _length += n;
+
+        return true;
+    }
+
+    std::size_t _length;
+    std::size_t _mark;
+};
+
+NAMESPACE_CORE_END
@@ -0,0 +1,504 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Hash.hpp>
+#include <core/String.hpp>
+#include <core/ConstString.hpp>
+#include <core/SizedString.hpp>
+#include <core/PaddedString.hpp>
+#include <core/StringLiteral.hpp>
+#include <core/StringBuffer.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+class StringSplit;
+
+/*! \brief StringView
+ *
+ * core::StringView is a pointer and a length: it refers to (part of) a string owned by someone else,
+ * so building it, taking parts of it and splitting it never copy characters.
+ *
+ * \code
+ * for (core::StringView part : core::StringView(name).split('/')) {
+ *     if (part.startsWith("imu")) { ... }
+ * }
+ * \endcode
+ *
+ * Searches use memchr, that is word-at-a-time or SIMD in any decent libc, to find candidates,
+ * and memcmp to confirm them.
+ *
+ * \warning The viewed characters are not \0 terminated, in general.
+ * \warning The view must not outlive the string it refers to.
+ */
+class StringView
+{
+public:
+    using size_type = std::size_t;
+
+    static const size_type NPOS = static_cast<size_type>(-1); //!< "not found", or "up to the end"
+
+    constexpr
+    StringView() : _data(""), _length(0) {}
+
+    constexpr
+    StringView(
+        const char* s, //!< [in] characters
+        size_type   n //!< [in] their number
+    ) : _data(s), _length(n) {}
+
+    /*! \brief View of a \0 terminated string, empty if s is nullptr
+     *
+     */
+    StringView(
+        const char* s
+    ) : _data((s != nullptr) ? s : ""), _length((s != nullptr) ? std::strlen(s) : 0) {}
+
+    constexpr
+    StringView(
+        const StringLiteral& s
+    ) : _data(s.data()), _length(s.length()) {}
+
+    template <std::size_t S>
+    StringView(
+        const String<S>& s
+    ) : _data(s.data()), _length(s.length()) {}
+
+    template <std::size_t S>
+    StringView(
+        const ConstString<S>& s
+    ) : _data(s.data()), _length(s.length()) {}
+
+    template <std::size_t S>
+    StringView(
+        const SizedString<S>& s
+    ) : _data(s.data()), _length(s.length()) {}
+
+    template <std::size_t S>
+    StringView(
+        const PaddedString<S>& s
+    ) : _data(s.data()), _length(s.length()) {}
+
+    StringView(
+        const StringWriter& s
+    ) : _data(s.c_str()), _length(s.length()) {}
+
+    template <std::size_t S>
+    StringView(
+        const StringBuffer<S>& s
+    ) : _data(s.c_str()), _length(s.length()) {}
+
+    constexpr const char*
+    data() const
+    {
+        return _data;
+    }
+
+    constexpr size_type
+    length() const
+    {
+        return _length;
+    }
+
+    constexpr size_type
+    size() const
+    {
+        return _length;
+    }
+
+    constexpr bool
+    empty() const
+    {
+        return _length == 0;
+    }
+
+    constexpr char
+    operator[](
+        size_type i
+    ) const
+    {
+        return _data[i];
+    }
+
+    constexpr const char*
+    begin() const
+    {
+        return _data;
+    }
+
+    constexpr const char*
+    end() const
+    {
+        return _data + _length;
+    }
+
+    /*! \brief Part of the view
+     *
+     * \return the (at most) \c n characters from \c pos, empty if \c pos is past the end
+     */
+    constexpr StringView
+    substr(
+        size_type pos,
+        size_type n = NPOS
+    ) const
+    {
+        return (pos >= _length) ? StringView(_data + _length, 0) : StringView(_data + pos, (n < _length - pos) ? n : _length - pos);
+    }
+
+    /*! \brief Position of the first \c c, starting from \c pos
+     *
+     * \return the position, NPOS if there is none
+     */
+    size_type
+    find(
+        char      c,
+        size_type pos = 0
+    ) const
+    {
+        if (pos >= _length) {
+            return NPOS;
+        }
+
+        const void* p = std::memchr(_data + pos, c, _length - pos);
+
+        return (p != nullptr) ? static_cast<size_type>(static_cast<const char*>(p) - _data) : NPOS;
+    }
+
+    /*! \brief Position of the first occurrence of \c s, starting from \c pos
+     *
+     * Candidates are the positions of the first character of \c s, found with memchr,
+     * that also have the last character of \c s in its place; only those are compared.
+     *
+     * \return the position, NPOS if there is none
+     */
+    size_type
+    find(
+        const StringView& s,
+        size_type         pos = 0
+    ) const
+    {
+        if (s._length == 0) {
+            return (pos <= _length) ? pos : NPOS;
+        }
+
+        if ((pos >= _length) || (s._length > _length - pos)) {
+            return NPOS;
+        }
+
+        const char        first = s._data[0];
+        const char        last  = s._data[s._length - 1];
+        const char*       p     = _data + pos;
+        const char* const top   = _data + (_length - s._length) + 1; // last possible start, excluded
+
+        while (p < top) {
+            p = static_cast<const char*>(std::memchr(p, first, static_cast<size_type>(top - p)));
+
+            if (p == nullptr) {
+                return NPOS;
+            }
+
+            if ((p[s._length - 1] == last) && (std::memcmp(p + 1, s._data + 1, s._length - 1) == 0)) {
+                return static_cast<size_type>(p - _data);
+            }
+
+            p++;
+        }
+
+        return NPOS;
+    } // find
+
+    /*! \brief Position of the last \c c
+     *
+     * \return the position, NPOS if there is none
+     */
+    size_type
+    rfind(
+        char c
+    ) const
+    {
+        for (size_type i = _length; i > 0; i--) {
+            if (_data[i - 1] == c) {
+                return i - 1;
+            }
+        }
+
+        return NPOS;
+    }
+
+    bool
+    contains(
+        char c
+    ) const
+    {
+        return find(c) != NPOS;
+    }
+
+    bool
+    contains(
+        const StringView& s
+    ) const
+    {
+        return find(s) != NPOS;
+    }
+
+    bool
+    startsWith(
+        const StringView& s
+    ) const
+    {
+        return (s._length <= _length) && (std::memcmp(_data, s._data, s._length) == 0);
+    }
+
+    bool
+    endsWith(
+        const StringView& s
+    ) const
+    {
+        return (s._length <= _length) && (std::memcmp(_data + _length - s._length, s._data, s._length) == 0);
+    }
+
+    /*! \brief Three-way comparison
+     *
+     * \return <0, 0 or >0, as strcmp
+     */
+    int
+    compare(
+        const StringView& s
+    ) const
+    {
+        const size_type n = (_length < s._length) ? _length : s._length;
+        const int       c = std::memcmp(_data, s._data, n);
+
+        if (c != 0) {
+            return c;
+        }
+
+        return (_length < s._length) ? -1 : ((_length > s._length) ? 1 : 0);
+    }
+
+    bool
+    equals(
+        const StringView& s
+    ) const
+    {
+        return (_length == s._length) && (std::memcmp(_data, s._data, _length) == 0);
+    }
+
+    /*! \brief Hash of the characters, as computed by Hash::string
+     *
+     */
+    uint64_t
+    hash() const
+    {
+        return Hash::string(_data, _length);
+    }
+
+    /*! \brief Copy the characters to a \0 terminated buffer
+     *
+     * \return false if they do not fit, and have been truncated
+     */
+    bool
+    copyTo(
+        char*     buffer, //!< [out] destination
+        size_type size //!< [in] its size, the \0 included
+    ) const
+    {
+        if (size == 0) {
+            return false;
+        }
+
+        const size_type n = (_length < size) ? _length : size - 1;
+
+        std::memcpy(buffer, _data, n);
+        buffer[n] = 0;
+
+        return n == _length;
+    }
+
+    /*! \brief The parts separated by \c separator
+     *
+     * As many parts as separators plus one: "a//b/" gives "a", "", "b" and "".
+     */
+    StringSplit
+    split(
+        char separator
+    ) const;
+
+private:
+    const char* _data;
+    size_type   _length;
+};
+
+/*! \brief Parts of a StringView
+ *
+ * A range of StringView, computed while iterating.
+ */
+class StringSplit
+{
+public:
+    class Iterator
+    {
+public:
+        Iterator() : _separator(0), _more(false), _end(true) {}
+
+        Iterator(
+            const StringView& s,
+            char              separator
+        ) : _rest(s), _separator(separator), _more(true), _end(false)
+        {
+            next();
+        }
+
+        const StringView&
+        operator*() const
+        {
+            return _part;
+        }
+
+        const StringView*
+        operator->() const
+        {
+            return &_part;
+        }
+
+        Iterator&
+        operator++()
+        {
+            next();
+            return *this;
+        }
+
+        bool
+        operator==(
+            const Iterator& rhs
+        ) const
+        {
+            return (_end == rhs._end) && (_end || (_part.data() == rhs._part.data()));
+        }
+
+        bool
+        operator!=(
+            const Iterator& rhs
+        ) const
+        {
+            return !(*this == rhs);
+        }
+
+private:
+        void
+        next()
+        {
+            if (!_more) {
+                _end = true;
+                return;
+            }
+
+            const StringView::size_type i = _rest.find(_separator);
+
+            if (i == StringView::NPOS) {
+                _part = _rest;
+                _more = false;
+            } else {
+                _part = _rest.substr(0, i);
+                _rest = _rest.substr(i + 1);
+            }
+        }
+
+        StringView _part;
+        StringView _rest;
+        char       _separator;
+        bool       _more;
+        bool       _end;
+    };
+
+    StringSplit(
+        const StringView& s,
+        char              separator
+    ) : _string(s), _separator(separator) {}
+
+    Iterator
+    begin() const
+    {
+        return Iterator(_string, _separator);
+    }
+
+    Iterator
+    end() const
+    {
+        return Iterator();
+    }
+
+private:
+    StringView _string;
+    char       _separator;
+};
+
+inline StringSplit
+StringView::split(
+    char separator
+) const
+{
+    return StringSplit(*this, separator);
+}
+
+inline bool
+operator==(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return lhs.equals(rhs);
+}
+
+inline bool
+operator!=(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return !lhs.equals(rhs);
+}
+
+inline bool
+operator<(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+inline bool
+operator>(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return lhs.compare(rhs) > 0;
+}
+
+inline bool
+operator<=(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+inline bool
+operator>=(
+    const StringView& lhs,
+    const StringView& rhs
+)
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+NAMESPACE_CORE_END
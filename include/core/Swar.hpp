@@ -0,0 +1,188 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief SIMD within a register
+ *
+ * Byte-parallel tests on native machine words (32 bit on Cortex-M, 64 bit on the host),
+ * used by the string kernels to skip over "uninteresting" bytes one word at a time.
+ *
+ * The tests are exact in telling whether a word contains a matching byte;
+ * the position of the first match is given by firstByte (little endian).
+ */
+namespace Swar {
+using Word = std::size_t;
+
+static const std::size_t WORD_SIZE = sizeof(Word);
+
+/*! \brief Unaligned load
+ *
+ */
+CORE_FORCE_INLINE Word
+load(
+    const void* p
+)
+{
+    Word w;
+
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+/*! \brief Unaligned store
+ *
+ */
+CORE_FORCE_INLINE void
+store(
+    void* p,
+    Word  w
+)
+{
+    std::memcpy(p, &w, sizeof(w));
+}
+
+/*! \brief Word with all bytes set to \c b
+ *
+ */
+constexpr Word
+broadcast(
+    uint8_t b
+)
+{
+    return (~static_cast<Word>(0) / 0xFF) * b;
+}
+
+/*! \brief High bit set in the bytes that are zero
+ *
+ * Exact: unlike the cheaper (w - 0x01..) & ~w & 0x80.., it does not flag the bytes after a zero one.
+ */
+CORE_FORCE_INLINE Word
+zeroBytes(
+    Word w
+)
+{
+    const Word low7 = broadcast(0x7F);
+
+    return ~(((w & low7) + low7) | w | low7);
+}
+
+/*! \brief High bit set in the bytes equal to \c b
+ *
+ */
+CORE_FORCE_INLINE Word
+equalBytes(
+    Word    w,
+    uint8_t b
+)
+{
+    return zeroBytes(w ^ broadcast(b));
+}
+
+/*! \brief High bit set in the bytes less than \c n
+ *
+ * \pre 1 <= n <= 128
+ */
+CORE_FORCE_INLINE Word
+lessBytes(
+    Word    w,
+    uint8_t n
+)
+{
+    const Word low7 = broadcast(0x7F);
+
+    // (b & 0x7F) + (128 - n) carries into the high bit iff (b & 0x7F) >= n
+    return ~(((w & low7) + broadcast(static_cast<uint8_t>(128 - n))) | w) & broadcast(0x80);
+}
+
+/*! \brief High bit set in the bytes that are not 7 bit ASCII
+ *
+ */
+CORE_FORCE_INLINE Word
+nonAsciiBytes(
+    Word w
+)
+{
+    return w & broadcast(0x80);
+}
+
+/*! \brief Index of the first flagged byte
+ *
+ * \pre mask != 0, little endian
+ */
+CORE_FORCE_INLINE std::size_t
+firstByte(
+    Word mask
+)
+{
+    return static_cast<std::size_t>(__builtin_ctzll(static_cast<unsigned long long>(mask))) >> 3;
+}
+
+/*! \brief Length of a \0 terminated string, reading at most \c n bytes
+ *
+ * Word-at-a-time version of strnlen.
+ * Words are read only within [s, s + n), so s does not need to be \0 terminated.
+ */
+inline std::size_t
+length(
+    const char* s,
+    std::size_t n
+)
+{
+    std::size_t i = 0;
+
+    for (; i + WORD_SIZE <= n; i += WORD_SIZE) {
+        Word mask = zeroBytes(load(s + i));
+
+        if (mask != 0) {
+            return i + firstByte(mask);
+        }
+    }
+
+    for (; i < n; i++) {
+        if (s[i] == 0) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+/*! \brief Compare two blocks of \c n bytes
+ *
+ * Differences are OR-ed together one word at a time, with no branch per word;
+ * for a constant \c n the loop is unrolled, or vectorized.
+ */
+CORE_FORCE_INLINE bool
+equal(
+    const void* a,
+    const void* b,
+    std::size_t n
+)
+{
+    const char* const pa   = static_cast<const char*>(a);
+    const char* const pb   = static_cast<const char*>(b);
+    Word              diff = 0;
+    std::size_t       i    = 0;
+
+    for (; i + WORD_SIZE <= n; i += WORD_SIZE) {
+        diff |= load(pa + i) ^ load(pb + i);
+    }
+
+    for (; i < n; i++) {
+        diff |= static_cast<Word>(static_cast<uint8_t>(pa[i] ^ pb[i]));
+    }
+
+    return diff == 0;
+}
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,344 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#pragma once
+
+#include <core/namespace.hpp>
+#include <core/common.hpp>
+#include <core/Swar.hpp>
+#include <core/ConstArray.hpp>
+#include <core/StringView.hpp>
+
+NAMESPACE_CORE_BEGIN
+
+/*! \brief Text validation
+ *
+ * Checks for text that comes in from the outside (names, string fields of messages),
+ * cheap enough to be done on every message:
+ * - firstNonAscii: 7 bit ASCII;
+ * - firstNonPrintable: printable ASCII, 0x20 (space) to 0x7E (~);
+ * - firstInvalid: well-formed UTF-8 (RFC 3629), so no overlong forms, no surrogates, nothing above U+10FFFF.
+ *
+ * Each returns the offset of the first offending byte, or the length of the text if there is none.
+ * For UTF-8, that is the first byte of the first ill-formed sequence, also when it is truncated by the end of the text.
+ *
+ * Text is scanned one machine word at a time (see Swar), and runs of ASCII cost a load and a test per word;
+ * multi-byte UTF-8 sequences are decoded one by one. The Scalar versions check one byte at a time, and give the same results:
+ * they are the reference for the fast ones.
+ *
+ * Strings are checked up to their length (the first \0); ConstArray<char, N> as N raw bytes.
+ *
+ * \code
+ * if (!Utf8::isValid(message.name)) {
+ *     return false;
+ * }
+ * \endcode
+ */
+namespace Utf8 {
+namespace Scalar {
+/*! \brief Length of the well-formed UTF-8 sequence at \c p
+ *
+ * \return 1 to 4, or 0 if the sequence is ill-formed or truncated
+ */
+inline std::size_t
+sequence(
+    const uint8_t* p, //!< [in] first byte
+    std::size_t    n //!< [in] bytes available from p, at least 1
+)
+{
+    const uint8_t b = p[0];
+
+    if (b < 0x80) {
+        return 1;
+    }
+
+    // Allowed range of the second byte, that rules out overlong forms, surrogates, and values above U+10FFFF
+    uint8_t     low  = 0x80;
+    uint8_t     high = 0xBF;
+    std::size_t length;
+
+    if ((b >= 0xC2) && (b <= 0xDF)) {
+        length = 2;
+    } else if ((b >= 0xE0) && (b <= 0xEF)) {
+        length = 3;
+        low    = (b == 0xE0) ? 0xA0 : 0x80;
+        high   = (b == 0xED) ? 0x9F : 0xBF;
+    } else if ((b >= 0xF0) && (b <= 0xF4)) {
+        length = 4;
+        low    = (b == 0xF0) ? 0x90 : 0x80;
+        high   = (b == 0xF4) ? 0x8F : 0xBF;
+    } else {
+        return 0;
+    }
+
+    if ((n < length) || (p[1] < low) || (p[1] > high)) {
+        return 0;
+    }
+
+    for (std::size_t i = 2; i < length; i++) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+
+    return length;
+} // sequence
+
+inline std::size_t
+firstNonAscii(
+    const char* s,
+    std::size_t n
+)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        if (static_cast<uint8_t>(s[i]) >= 0x80) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+inline std::size_t
+firstNonPrintable(
+    const char* s,
+    std::size_t n
+)
+{
+    for (std::size_t i = 0; i < n; i++) {
+        const uint8_t b = static_cast<uint8_t>(s[i]);
+
+        if ((b < 0x20) || (b > 0x7E)) {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+inline std::size_t
+firstInvalid(
+    const char* s,
+    std::size_t n
+)
+{
+    const uint8_t* const p = reinterpret_cast<const uint8_t*>(s);
+    std::size_t          i = 0;
+
+    while (i < n) {
+        const std::size_t l = sequence(p + i, n - i);
+
+        if (l == 0) {
+            return i;
+        }
+
+        i += l;
+    }
+
+    return n;
+}
+}
+
+/*! \brief Offset of the first byte that is not 7 bit ASCII
+ *
+ * \return the offset, \c n if there is none
+ */
+inline std::size_t
+firstNonAscii(
+    const char* s, //!< [in] text
+    std::size_t n //!< [in] its length
+)
+{
+    std::size_t i = 0;
+
+    // Two words per test: one branch every 16 bytes on the host
+    for (; i + 2 * Swar::WORD_SIZE <= n; i += 2 * Swar::WORD_SIZE) {
+        if (Swar::nonAsciiBytes(Swar::load(s + i) | Swar::load(s + i + Swar::WORD_SIZE)) != 0) {
+            break;
+        }
+    }
+
+    for (; i + Swar::WORD_SIZE <= n; i += Swar::WORD_SIZE) {
+        const Swar::Word mask = Swar::nonAsciiBytes(Swar::load(s + i));
+
+        if (mask != 0) {
+            return i + Swar::firstByte(mask);
+        }
+    }
+
+    return i + Scalar::firstNonAscii(s + i, n - i);
+}
+
+/*! \brief Offset of the first byte that is not printable ASCII (0x20 to 0x7E)
+ *
+ * \return the offset, \c n if there is none
+ */
+inline std::size_t
+firstNonPrintable(
+    const char* s, //!< [in] text
+    std::size_t n //!< [in] its length
+)
+{
+    std::size_t i = 0;
+
+    for (; i + Swar::WORD_SIZE <= n; i += Swar::WORD_SIZE) {
+        const Swar::Word w    = Swar::load(s + i);
+        const Swar::Word mask = Swar::nonAsciiBytes(w) | Swar::lessBytes(w, 0x20) | Swar::equalBytes(w, 0x7F);
+
+        if (mask != 0) {
+            return i + Swar::firstByte(mask);
+        }
+    }
+
+    return i + Scalar::firstNonPrintable(s + i, n - i);
+}
+
+/*! \brief Offset of the first ill-formed UTF-8 sequence
+ *
+ * Runs of ASCII are skipped by firstNonAscii; the sequences in between are decoded one by one.
+ *
+ * \return the offset, \c n if the text is well-formed
+ */
+inline std::size_t
+firstInvalid(
+    const char* s, //!< [in] text
+    std::size_t n //!< [in] its length
+)
+{
+    const uint8_t* const p = reinterpret_cast<const uint8_t*>(s);
+    std::size_t          i = firstNonAscii(s, n);
+
+    while (i < n) {
+        const std::size_t l = Scalar::sequence(p + i, n - i);
+
+        if (l == 0) {
+            return i;
+        }
+
+        i += l;
+
+        // Multi-byte sequences tend to come in runs: back to the word loop only when they end
+        if ((i < n) && (p[i] < 0x80)) {
+            i += firstNonAscii(s + i, n - i);
+        }
+    }
+
+    return n;
+} // firstInvalid
+
+inline std::size_t
+firstNonAscii(
+    const StringView& s
+)
+{
+    return firstNonAscii(s.data(), s.length());
+}
+
+inline std::size_t
+firstNonPrintable(
+    const StringView& s
+)
+{
+    return firstNonPrintable(s.data(), s.length());
+}
+
+inline std::size_t
+firstInvalid(
+    const StringView& s
+)
+{
+    return firstInvalid(s.data(), s.length());
+}
+
+template <std::size_t N>
+inline std::size_t
+firstNonAscii(
+    const ConstArray<char, N>& a
+)
+{
+    return firstNonAscii(a.data(), N);
+}
+
+template <std::size_t N>
+inline std::size_t
+firstNonPrintable(
+    const ConstArray<char, N>& a
+)
+{
+    return firstNonPrintable(a.data(), N);
+}
+
+template <std::size_t N>
+inline std::size_t
+firstInvalid(
+    const ConstArray<char, N>& a
+)
+{
+    return firstInvalid(a.data(), N);
+}
+
+/*! \brief Tell whether a String, ConstString, SizedString, StringBuffer or StringView is 7 bit ASCII
+ *
+ */
+inline bool
+isAscii(
+    const StringView& s
+)
+{
+    return firstNonAscii(s) == s.length();
+}
+
+/*! \brief Tell whether a String, ConstString, SizedString, StringBuffer or StringView is printable ASCII
+ *
+ */
+inline bool
+isPrintable(
+    const StringView& s
+)
+{
+    return firstNonPrintable(s) == s.length();
+}
+
+/*! \brief Tell whether a String, ConstString, SizedString, StringBuffer or StringView is well-formed UTF-8
+ *
+ */
+inline bool
+isValid(
+    const StringView& s
+)
+{
+    return firstInvalid(s) == s.length();
+}
+
+template <std::size_t N>
+inline bool
+isAscii(
+    const ConstArray<char, N>& a
+)
+{
+    return firstNonAscii(a) == N;
+}
+
+template <std::size_t N>
+inline bool
+isPrintable(
+    const ConstArray<char, N>& a
+)
+{
+    return firstNonPrintable(a) == N;
+}
+
+template <std::size_t N>
+inline bool
+isValid(
+    const ConstArray<char, N>& a
+)
+{
+    return firstInvalid(a) == N;
+}
+}
+
+NAMESPACE_CORE_END
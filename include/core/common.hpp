@@ -45,6 +45,16 @@
 #define CORE_MEMORY_ALIGNED  __attribute__((aligned(sizeof(unsigned))))
 #endif
 
+/* Distance that keeps data written by different cores out of the same cache line (no false sharing).
+ * Cortex-M parts have no data cache, or a single core: there it is just the word size, to save RAM. */
+#ifndef CORE_CACHE_LINE_SIZE
+#if defined(__arm__)
+#define CORE_CACHE_LINE_SIZE 4
+#else
+#define CORE_CACHE_LINE_SIZE 64
+#endif
+#endif
+
 #define CORE_PACKED          __attribute__((packed))
 #define CORE_PACKED_ALIGNED  __attribute__((aligned(4), packed))
 
@@ -73,7 +83,7 @@ static_cast_check()
     (void)pb;
 }
 
-inline
+constexpr
 size_t
 bit_mask(
     size_t num_bits
@@ -82,7 +92,7 @@ bit_mask(
     return (static_cast<size_t>(1) << num_bits) - 1;
 }
 
-inline
+constexpr
 size_t
 byte_mask(
     size_t num_bytes
@@ -91,6 +101,28 @@ byte_mask(
     return bit_mask(num_bytes << 3);
 }
 
+constexpr
+size_t
+round_up_pow2(
+    size_t n
+)
+{
+    // A single return statement, so that it stays a C++11 constexpr
+    return (n <= 1) ? 1 : 2 * round_up_pow2((n + 1) >> 1);
+}
+
+/*! \brief Base 2 logarithm of a power of 2
+ *
+ */
+constexpr
+size_t
+log2_pow2(
+    size_t n
+)
+{
+    return (n <= 1) ? 0 : 1 + log2_pow2(n >> 1);
+}
+
 template <typename T>
 inline
 size_t
@@ -161,3 +193,13 @@ compute_offset(
 
 #define TEST_TOPIC_NAME "test"
 #define TEST_TOPIC_ID ((uint8_t)0xFE)
+
+/*! \brief Entries of the system topics, for a NameTable
+ *
+ */
+#define CORE_SYSTEM_TOPICS \
+    {MANAGEMENT_TOPIC_NAME, MANAGEMENT_TOPIC_ID}, \
+    {RPC_TOPIC_NAME, RPC_TOPIC_ID}, \
+    {BOOTLOADER_MASTER_TOPIC_NAME, BOOTLOADER_MASTER_TOPIC_ID}, \
+    {BOOTLOADER_TOPIC_NAME, BOOTLOADER_TOPIC_ID}, \
+    {TEST_TOPIC_NAME, TEST_TOPIC_ID}
@@ -0,0 +1,387 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+#include <core/BinaryLog.hpp>
+#include <core/Format.hpp>
+
+#include <cstdio>
+
+NAMESPACE_CORE_BEGIN
+
+namespace {
+struct Argument {
+    CoreType    type;
+    uint64_t    bits; // integers, zero extended
+    double      real;
+    const char* string;
+};
+
+bool
+readArgument(
+    const uint8_t*& p,
+    const uint8_t*  end,
+    Argument&       argument
+)
+{
+    if (p >= end) {
+        return false;
+    }
+
+    argument.type = static_cast<CoreType>(*p++);
+
+    if (argument.type == CoreType::CHAR) {
+        uint16_t n;
+
+        if ((end - p) < static_cast<std::ptrdiff_t>(sizeof(n))) {
+            return false;
+        }
+
+        std::memcpy(&n, p, sizeof(n));
+        p += sizeof(n);
+
+        if (n == 0) {
+            argument.string = nullptr;
+            return true;
+        }
+
+        if (((end - p) < n) || (p[n - 1] != 0)) {
+            return false;
+        }
+
+        argument.string = reinterpret_cast<const char*>(p);
+        p += n;
+        return true;
+    }
+
+    std::size_t size;
+
+    switch (argument.type) {
+      case CoreType::INT8:
+      case CoreType::UINT8:
+      case CoreType::INT16:
+      case CoreType::UINT16:
+      case CoreType::INT32:
+      case CoreType::UINT32:
+      case CoreType::INT64:
+      case CoreType::UINT64:
+      case CoreType::FLOAT32:
+      case CoreType::FLOAT64:
+          size = CoreTypeUtils::coreTypeSize(argument.type);
+          break;
+      default:
+          return false;
+    }
+
+    if ((end - p) < static_cast<std::ptrdiff_t>(size)) {
+        return false;
+    }
+
+    if (argument.type == CoreType::FLOAT32) {
+        float f;
+        std::memcpy(&f, p, sizeof(f));
+        argument.real = f;
+    } else if (argument.type == CoreType::FLOAT64) {
+        std::memcpy(&argument.real, p, sizeof(argument.real));
+    } else {
+        argument.bits = 0;
+        std::memcpy(&argument.bits, p, size); // little endian
+    }
+
+    p += size;
+    return true;
+} // readArgument
+
+/*! \brief Read a '*' field width or precision
+ *
+ * The target promoted the argument to int, as printf reads it.
+ */
+bool
+readInt(
+    const uint8_t*& p,
+    const uint8_t*  end,
+    int&            value
+)
+{
+    Argument argument;
+
+    if (!readArgument(p, end, argument)) {
+        return false;
+    }
+
+    switch (argument.type) {
+      case CoreType::INT8:
+          value = static_cast<int8_t>(argument.bits);
+          return true;
+      case CoreType::INT16:
+          value = static_cast<int16_t>(argument.bits);
+          return true;
+      case CoreType::UINT8:
+      case CoreType::UINT16:
+      case CoreType::INT32:
+      case CoreType::UINT32:
+      case CoreType::INT64:
+      case CoreType::UINT64:
+          value = static_cast<int32_t>(static_cast<uint32_t>(argument.bits));
+          return true;
+      default:
+          return false;
+    }
+}
+}
+
+int
+BinaryLogRecord::print(
+    char*       buffer,
+    std::size_t length,
+    const char* format
+) const
+{
+    const uint8_t* p   = data;
+    const uint8_t* end = data + this->length;
+    std::size_t    n   = 0;
+    std::size_t    i   = 0;
+
+    if ((format == nullptr) || (length == 0)) {
+        return -1;
+    }
+
+    for (;;) {
+        std::size_t pct = Format::next(format, i);
+
+        if ((pct - i) >= (length - n)) {
+            buffer[0] = 0;
+            return -1;
+        }
+
+        std::memcpy(buffer + n, format + i, pct - i);
+        n += pct - i;
+
+        if (format[pct] == 0) {
+            break;
+        }
+
+        Format::Spec spec = Format::parse(format, pct);
+
+        if (spec.conversion == '%') {
+            i = spec.end;
+
+            if ((length - n) < 2) {
+                buffer[0] = 0;
+                return -1;
+            }
+
+            buffer[n++] = '%';
+            continue;
+        }
+
+        // Rebuild the placeholder without length modifiers: "%" flags width precision,
+        // with the '*' width and precision replaced by the value of their argument
+        char        placeholder[48];
+        std::size_t k         = 1;
+        std::size_t j         = pct + 1;
+        unsigned    bits      = 64;
+        int         precision = -1;
+
+        placeholder[0] = '%';
+
+        while ((format[j] != 0) && (strchr("-+ #0123456789.*", format[j]) != nullptr)) {
+            if (k >= sizeof(placeholder) - 16) {
+                buffer[0] = 0;
+                return -1;
+            }
+
+            char c = format[j++];
+
+            if (c == '*') {
+                int value;
+
+                if (!readInt(p, end, value)) {
+                    buffer[0] = 0;
+                    return -1;
+                }
+
+                if (precision < 0) {
+                    // A negative width is a '-' flag followed by a width
+                    k += snprintf(placeholder + k, sizeof(placeholder) - k, "%d", value);
+                } else if (value < 0) {
+                    // A negative precision is taken as if it were omitted
+                    precision = -1;
+                    k--;
+                } else {
+                    precision = value;
+                    k += snprintf(placeholder + k, sizeof(placeholder) - k, "%d", value);
+                }
+
+                continue;
+            }
+
+            if (c == '.') {
+                precision = 0;
+            } else if ((precision >= 0) && (c >= '0') && (c <= '9') && (precision < 0xFFFF)) {
+                precision = precision * 10 + (c - '0');
+            }
+
+            placeholder[k++] = c;
+        }
+
+        if (format[j] == 'h') {
+            bits = (format[j + 1] == 'h') ? 8 : 16;
+        }
+
+        Argument argument;
+
+        if (!readArgument(p, end, argument)) {
+            buffer[0] = 0;
+            return -1;
+        }
+
+        int m = -1;
+
+        switch (spec.conversion) {
+          case 'd':
+          case 'i':
+          case 'u':
+          case 'o':
+          case 'x':
+          case 'X':
+          case 'c':
+          {
+              if ((argument.type == CoreType::CHAR) || (argument.type == CoreType::FLOAT32) || (argument.type == CoreType::FLOAT64)) {
+                  break;
+              }
+
+              // Convert as the target would have: arguments are promoted to int, then signed conversions see them as signed,
+              // unsigned ones as unsigned, both truncated as the hh and h length modifiers require
+              const bool isSignedConversion = (spec.conversion == 'd') || (spec.conversion == 'i');
+              const bool isSignedArgument   = (argument.type == CoreType::INT8) || (argument.type == CoreType::INT16)
+                                              || (argument.type == CoreType::INT32) || (argument.type == CoreType::INT64);
+              unsigned width = static_cast<unsigned>(CoreTypeUtils::coreTypeSize(argument.type)) * 8;
+              uint64_t value = argument.bits;
+
+              if (isSignedArgument && (width < 64) && ((value >> (width - 1)) & 1)) {
+                  value |= ~static_cast<uint64_t>(0) << width;
+              }
+
+              if (width < 32) {
+                  width = 32;
+              }
+
+              if (bits < width) {
+                  width = bits;
+              }
+
+              if (width < 64) {
+                  value &= (static_cast<uint64_t>(1) << width) - 1;
+
+                  if (isSignedConversion && ((value >> (width - 1)) & 1)) {
+                      value |= ~static_cast<uint64_t>(0) << width;
+                  }
+              }
+
+              if (spec.conversion == 'c') {
+                  placeholder[k++] = 'c';
+                  placeholder[k]   = 0;
+                  m = snprintf(buffer + n, length - n, placeholder, static_cast<int>(value));
+              } else {
+                  placeholder[k++] = 'l';
+                  placeholder[k++] = 'l';
+                  placeholder[k++] = spec.conversion;
+                  placeholder[k]   = 0;
+
+                  if (isSignedConversion) {
+                      m = snprintf(buffer + n, length - n, placeholder, static_cast<long long>(value));
+                  } else {
+                      m = snprintf(buffer + n, length - n, placeholder, static_cast<unsigned long long>(value));
+                  }
+              }
+
+              break;
+          }
+          case 'f':
+          case 'F':
+          case 'e':
+          case 'E':
+          case 'g':
+          case 'G':
+          case 'a':
+          case 'A':
+
+              if ((argument.type == CoreType::FLOAT32) || (argument.type == CoreType::FLOAT64)) {
+                  placeholder[k++] = spec.conversion;
+                  placeholder[k]   = 0;
+                  m = snprintf(buffer + n, length - n, placeholder, argument.real);
+              }
+
+              break;
+          case 's':
+
+              if (argument.type == CoreType::CHAR) {
+                  const char* s = argument.string;
+
+                  if (s == nullptr) {
+                      // As glibc does
+                      s = ((precision < 0) || (precision >= 6)) ? "(null)" : "";
+                  }
+
+                  placeholder[k++] = 's';
+                  placeholder[k]   = 0;
+                  m = snprintf(buffer + n, length - n, placeholder, s);
+              }
+
+              break;
+          default:
+              break;
+        } // switch
+
+        if ((m < 0) || (static_cast<std::size_t>(m) >= (length - n))) {
+            buffer[0] = 0;
+            return -1;
+        }
+
+        n += m;
+        i  = spec.end;
+    }
+
+    buffer[n] = 0;
+
+    // All the arguments must have been consumed
+    if (p != end) {
+        buffer[0] = 0;
+        return -1;
+    }
+
+    return static_cast<int>(n);
+} // BinaryLogRecord::print
+
+bool
+BinaryLogReader::next(
+    BinaryLogRecord& record
+)
+{
+    BinaryLogHeader header;
+
+    if ((_end - _curr) < static_cast<std::ptrdiff_t>(sizeof(header))) {
+        return false;
+    }
+
+    std::memcpy(&header, _curr, sizeof(header));
+
+    if ((header.size < sizeof(header)) || ((_end - _curr) < header.size)) {
+        return false;
+    }
+
+    record.format    = header.format;
+    record.timestamp = header.timestamp;
+    record.arguments = header.arguments;
+    record.data      = _curr + sizeof(header);
+    record.length    = header.size - sizeof(header);
+
+    _curr += header.size;
+
+    return true;
+}
+
+NAMESPACE_CORE_END
@@ -0,0 +1,91 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+/* Host tool: decode a core::BinaryLog dump.
+ *
+ * The format strings are resolved from a raw image of the section that holds them on the target:
+ *
+ *     arm-none-eabi-objcopy -O binary --only-section=.rodata firmware.elf rodata.bin
+ *     BinaryLogDecode log.bin rodata.bin 0x08012345
+ *
+ * where the last argument is the address of the section (arm-none-eabi-objdump -h firmware.elf).
+ * Each record is printed on its own line, prefixed by its timestamp.
+ */
+
+#include <core/BinaryLog.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+static bool
+load(
+    const char*           path,
+    std::vector<uint8_t>& data
+)
+{
+    FILE* f = fopen(path, "rb");
+
+    if (f == nullptr) {
+        return false;
+    }
+
+    uint8_t     chunk[4096];
+    std::size_t n;
+
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        data.insert(data.end(), chunk, chunk + n);
+    }
+
+    fclose(f);
+    return true;
+}
+
+int
+main(
+    int   argc,
+    char* argv[]
+)
+{
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <log.bin> <rodata.bin> <rodata address>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> log;
+    std::vector<uint8_t> rodata;
+
+    if (!load(argv[1], log) || !load(argv[2], rodata)) {
+        fprintf(stderr, "Cannot read the input files\n");
+        return EXIT_FAILURE;
+    }
+
+    rodata.push_back(0); // make sure the last string is terminated
+
+    const uint64_t base = strtoull(argv[3], nullptr, 0);
+
+    core::BinaryLogReader reader(log.data(), log.size());
+    core::BinaryLogRecord record;
+    static char text[0x10000];
+
+    while (reader.next(record)) {
+        if ((record.format < base) || ((record.format - base) >= rodata.size())) {
+            printf("%llu: <unknown format string at 0x%08llx>\n", static_cast<unsigned long long>(record.timestamp), static_cast<unsigned long long>(record.format));
+            continue;
+        }
+
+        const char* format = reinterpret_cast<const char*>(rodata.data() + (record.format - base));
+
+        if (record.print(text, sizeof(text), format) < 0) {
+            printf("%llu: <cannot decode \"%s\">\n", static_cast<unsigned long long>(record.timestamp), format);
+            continue;
+        }
+
+        printf("%llu: %s\n", static_cast<unsigned long long>(record.timestamp), text);
+    }
+
+    return EXIT_SUCCESS;
+} // main
@@ -0,0 +1,138 @@
+/* COPYRIGHT (c) 2016-2018 Nova Labs SRL
+ *
+ * All rights reserved. All use of this software and documentation is
+ * subject to the License Agreement located in the file LICENSE.
+ */
+
+/* Host tool: check core::NumberFormat::formatShortest against std::to_chars, and time it against vsnprintf.
+ *
+ * Every one of the 2^32 float bit patterns is written with both, and the outputs must be the same:
+ *
+ *     g++ -std=c++17 -O2 -I include tools/NumberFormatCheck.cpp src/NumberFormat.cpp -o NumberFormatCheck
+ *     NumberFormatCheck [stride]
+ *
+ * A stride greater than 1 checks only one pattern out of stride, for a quicker run.
+ * The exit status is EXIT_FAILURE if any output differs.
+ */
+
+#include <core/NumberFormat.hpp>
+
+#include <charconv>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static int
+formatPrintf(
+    char*       buffer,
+    std::size_t length,
+    const char* format,
+    ...
+)
+{
+    va_list args;
+
+    va_start(args, format);
+    int n = vsnprintf(buffer, length, format, args);
+    va_end(args);
+
+    return n;
+}
+
+static float
+toFloat(
+    uint32_t bits
+)
+{
+    float value;
+
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static void
+benchmark(
+    uint64_t stride
+)
+{
+    using Clock = std::chrono::steady_clock;
+
+    char     buffer[32];
+    uint64_t count = 0;
+    uint64_t sink  = 0;
+
+    // Finite values only, all exponents: one pattern out of stride * 16
+    const uint64_t step = stride * 16 + 1;
+
+    auto start = Clock::now();
+
+    for (uint64_t bits = 0; bits < 0x7F800000u; bits += step) {
+        sink += core::NumberFormat::formatShortest(buffer, sizeof(buffer), toFloat(static_cast<uint32_t>(bits)));
+        count++;
+    }
+
+    auto middle = Clock::now();
+
+    for (uint64_t bits = 0; bits < 0x7F800000u; bits += step) {
+        sink += formatPrintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(toFloat(static_cast<uint32_t>(bits))));
+    }
+
+    auto end = Clock::now();
+
+    const double shortestTime = std::chrono::duration<double, std::nano>(middle - start).count() / count;
+    const double printfTime   = std::chrono::duration<double, std::nano>(end - middle).count() / count;
+
+    printf("formatShortest: %.1f ns/value\n", shortestTime);
+    printf("vsnprintf %%.9g: %.1f ns/value (%llu values, %llu characters)\n", printfTime, static_cast<unsigned long long>(count), static_cast<unsigned long long>(sink));
+} // benchmark
+
+int
+main(
+    int   argc,
+    char* argv[]
+)
+{
+    if (argc > 2) {
+        fprintf(stderr, "Usage: %s [stride]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t stride = (argc == 2) ? strtoull(argv[1], nullptr, 0) : 1;
+
+    if (stride == 0) {
+        fprintf(stderr, "The stride must be at least 1\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t checked    = 0;
+    uint64_t mismatches = 0;
+
+    for (uint64_t bits = 0; bits <= 0xFFFFFFFFu; bits += stride) {
+        const float value = toFloat(static_cast<uint32_t>(bits));
+
+        char actual[32];
+        char expected[32];
+
+        int  n = core::NumberFormat::formatShortest(actual, sizeof(actual), value);
+        auto r = std::to_chars(expected, expected + sizeof(expected) - 1, value);
+
+        *r.ptr = 0;
+        checked++;
+
+        if ((n != (r.ptr - expected)) || (std::strcmp(actual, expected) != 0)) {
+            if (mismatches < 20) {
+                printf("0x%08x: \"%s\", expected \"%s\"\n", static_cast<unsigned>(bits), (n < 0) ? "" : actual, expected);
+            }
+
+            mismatches++;
+        }
+    }
+
+    printf("%llu values checked, %llu mismatches\n", static_cast<unsigned long long>(checked), static_cast<unsigned long long>(mismatches));
+
+    benchmark(stride);
+
+    return (mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+} // main